@@ -0,0 +1,85 @@
+// Duplex round trips: synchronous call() vs. pipelined try_call()/try_take() at a fixed depth.
+// Build: g++ -std=c++20 -O2 -pthread -Iinclude bench/duplex_latency.cpp -o duplex_bench
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "spsc_duplex.h"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Check { std::uint64_t account; std::int64_t qty; };
+    struct Verdict { bool ok; };
+
+    std::int64_t nowNs() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    void report(const char* name, std::vector<std::int64_t>& s, double secs)
+    {
+        std::sort(s.begin(), s.end());
+        auto q = [&](double p) { return static_cast<long long>(s[static_cast<std::size_t>(p * static_cast<double>(s.size() - 1))]); };
+        std::printf("%-14s %8.2f Mcall/s  p50=%lld ns  p99=%lld ns  p99.9=%lld ns\n", name,
+            static_cast<double>(s.size()) / secs / 1e6, q(0.50), q(0.99), q(0.999));
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    SPSC::Duplex<Check, Verdict> risk(1024);
+    std::jthread server([&](std::stop_token st) {
+        while (!st.stop_requested())
+            if (!risk.serve([](Check& c) { return Verdict{ c.qty < 1000 }; })) std::this_thread::yield();
+    });
+
+    std::vector<std::int64_t> lat;
+    lat.reserve(calls);
+
+    // ------------------------ Synchronous: one outstanding call ------------------------
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < calls; ++i) {
+        std::int64_t s = nowNs();
+        risk.call<SPSC::Wait::Yield>(Check{ i, static_cast<std::int64_t>(i & 2047) });
+        lat.push_back(nowNs() - s);
+    }
+    report("sync", lat, std::chrono::duration<double>(Clock::now() - t0).count());
+
+    // ------------------------ Pipelined: keep `depth` calls in flight ------------------
+    for (std::size_t depth : { 8u, 64u, 512u }) {
+        lat.clear();
+        std::vector<std::uint64_t> ids(depth);
+        std::vector<std::int64_t> start(depth);
+        std::size_t issued = 0, done = 0;
+        t0 = Clock::now();
+        while (done < calls) {
+            while (issued < calls && issued - done < depth) {
+                std::uint64_t id;
+                if (!risk.try_call(id, Check{ issued, 1 })) break;
+                ids[issued % depth] = id;
+                start[issued % depth] = nowNs();
+                ++issued;
+            }
+            Verdict v{};
+            // Responses come back in order from a single server, take the oldest first
+            while (done < issued && risk.try_take(ids[done % depth], v)) {
+                lat.push_back(nowNs() - start[done % depth]);
+                ++done;
+            }
+            if (done < issued) std::this_thread::yield();
+        }
+        char name[32];
+        std::snprintf(name, sizeof(name), "pipelined/%zu", depth);
+        report(name, lat, std::chrono::duration<double>(Clock::now() - t0).count());
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+// FileSink throughput: one producer thread, one sink thread, 64-byte records.
+// Build: g++ -std=c++20 -O2 -pthread -Iinclude bench/file_sink_throughput.cpp -o sink_bench
+// Usage: sink_bench [dir] [MiB]      (dir defaults to /tmp)
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#include "spsc_sink.h"
+
+namespace {
+    struct Rec
+    {
+        std::uint64_t seq;
+        std::uint64_t body[7];
+    };
+
+    void run(const char* label, const std::string& dir, std::uint64_t n, SPSC::FileSink<Rec>::Options opt, bool direct)
+    {
+        std::string path = dir + "/spsc_sink_bench.XXXXXX";
+        int fd = ::mkstemp(path.data());
+        if (direct) {
+            ::close(fd);
+            fd = ::open(path.c_str(), O_WRONLY | O_DIRECT);
+            if (fd < 0) { std::printf("%-24s O_DIRECT refused here, skipped\n", label); ::unlink(path.c_str()); return; }
+        }
+
+        SPSC::SpscRing<Rec> ring(1 << 14);
+        auto t0 = std::chrono::steady_clock::now();
+        std::uint64_t syncs = 0;
+        bool uring = false;
+        {
+            SPSC::FileSink<Rec> sink(fd, opt);
+            uring = sink.uses_io_uring();
+            std::jthread consumer([&](std::stop_token st) { sink.run(ring, st); });
+            for (std::uint64_t i = 0; i < n;) {
+                if (ring.try_push(Rec{ i, {} })) ++i;
+            }
+            consumer.request_stop();
+            consumer.join();
+            syncs = sink.syncs();
+        }
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        const double mib = static_cast<double>(n * sizeof(Rec)) / (1 << 20);
+        std::printf("%-24s %8.0f MiB/s  %6.2f Mrec/s  fsyncs=%llu%s\n", label, mib / s, static_cast<double>(n) / s / 1e6,
+            static_cast<unsigned long long>(syncs), uring ? "  (io_uring)" : "");
+        ::close(fd);
+        ::unlink(path.c_str());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::string dir = argc > 1 ? argv[1] : "/tmp";
+    const std::uint64_t mib = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 512;
+    const std::uint64_t n = (mib << 20) / sizeof(Rec);
+
+    using Opt = SPSC::FileSink<Rec>::Options;
+    Opt writev{};
+    Opt writev_gc{};
+    writev_gc.sync_bytes = 16 << 20;
+    Opt direct_pwrite{};
+    direct_pwrite.mode = SPSC::SinkMode::Direct;
+    direct_pwrite.io_uring = false;
+    Opt direct_uring = direct_pwrite;
+    direct_uring.io_uring = true;
+    Opt direct_uring_gc = direct_uring;
+    direct_uring_gc.sync_bytes = 16 << 20;
+
+    std::printf("%llu MiB to %s\n", static_cast<unsigned long long>(mib), dir.c_str());
+    run("writev", dir, n, writev, false);
+    run("writev + fsync/16MiB", dir, n, writev_gc, false);
+    run("O_DIRECT pwrite", dir, n, direct_pwrite, true);
+    run("O_DIRECT io_uring", dir, n, direct_uring, true);
+    run("O_DIRECT io_uring+fsync", dir, n, direct_uring_gc, true);
+    return 0;
+}
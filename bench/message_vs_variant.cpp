@@ -0,0 +1,76 @@
+// Mixed message stream: MessageRing (records sized per type) vs SpscRing<std::variant> (every slot
+// sized for the largest type). Same thread, bursts of 256; 90% small messages, 10% large.
+// Build: g++ -std=c++20 -O2 -pthread -Iinclude bench/message_vs_variant.cpp -o message_bench
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <variant>
+
+#include "spsc_message.h"
+#include "spsc_ring.h"
+
+namespace {
+    struct Heartbeat { std::uint32_t seq; };
+    struct Quote { std::uint64_t id; double bid, ask; std::uint32_t bid_qty, ask_qty; };
+    struct Snapshot { std::uint64_t id; double px[24]; };
+
+    using Variant = std::variant<Heartbeat, Quote, Snapshot>;
+    constexpr std::uint64_t kBurst = 256;
+
+    template <class Body>
+    double nsPerMsg(std::uint64_t rounds, Body body)
+    {
+        std::uint64_t sum = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (std::uint64_t r = 0; r < rounds; ++r) sum += body(r);
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        if (sum == 42) std::puts("");
+        return ns / static_cast<double>(rounds * kBurst);
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::uint64_t rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    const std::size_t ring_bytes = 64 * 1024;
+
+    SPSC::MessageRing<Heartbeat, Quote, Snapshot> msgs(ring_bytes);
+    SPSC::SpscRing<Variant> variants(ring_bytes / sizeof(Variant));
+
+    auto handle = SPSC::Overloaded{
+        [](Heartbeat& h) { return std::uint64_t{ h.seq }; },
+        [](Quote& q) { return q.id + q.bid_qty; },
+        [](Snapshot& s) { return s.id + static_cast<std::uint64_t>(s.px[23]); },
+    };
+
+    const double m = nsPerMsg(rounds, [&](std::uint64_t r) {
+        for (std::uint64_t i = 0; i < kBurst; ++i) {
+            if (i % 10 == 9) msgs.try_stage<Snapshot>(Snapshot{ r, {} });
+            else if (i & 1) msgs.try_stage<Quote>(Quote{ i, 1.0, 2.0, 3, 4 });
+            else msgs.try_stage<Heartbeat>(static_cast<std::uint32_t>(i));
+        }
+        msgs.publish();
+        std::uint64_t sum = 0;
+        msgs.poll([&](auto& msg) { sum += handle(msg); });
+        return sum;
+    });
+
+    const double v = nsPerMsg(rounds, [&](std::uint64_t r) {
+        for (std::uint64_t i = 0; i < kBurst; ++i) {
+            if (i % 10 == 9) variants.try_stage(Snapshot{ r, {} });
+            else if (i & 1) variants.try_stage(Quote{ i, 1.0, 2.0, 3, 4 });
+            else variants.try_stage(Heartbeat{ static_cast<std::uint32_t>(i) });
+        }
+        variants.publish();
+        std::uint64_t sum = 0;
+        for (Variant* p = variants.front(); p; p = variants.front()) { sum += std::visit(handle, *p); variants.pop_front(); }
+        return sum;
+    });
+
+    const double bytes_m = 0.5 * static_cast<double>(decltype(msgs)::footprint<Heartbeat>()) +
+                           0.4 * static_cast<double>(decltype(msgs)::footprint<Quote>()) +
+                           0.1 * static_cast<double>(decltype(msgs)::footprint<Snapshot>());
+    std::printf("MessageRing            %7.2f ns/msg  %6.1f bytes/msg\n", m, bytes_m);
+    std::printf("SpscRing<std::variant> %7.2f ns/msg  %6.1f bytes/msg\n", v, static_cast<double>(sizeof(Variant)));
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Replay rate: read() + copy into a ring of records vs MappedSource views into the mapping.
+// Build: g++ -std=c++20 -O2 -pthread -Iinclude bench/replay_source.cpp -o replay_bench
+// Usage: replay_bench [MiB] [record bytes]     (file is created under /tmp and removed)
+// Idle loops yield, so the comparison stays meaningful when both threads share one core.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "spsc_source.h"
+
+namespace {
+    constexpr std::size_t kMaxRecord = 256;
+
+    struct Copied
+    {
+        std::uint32_t size;
+        std::byte bytes[kMaxRecord];
+    };
+
+    double seconds(std::chrono::steady_clock::time_point t0)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t mib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512;
+    std::size_t rec = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+    if (rec < 8 || rec > kMaxRecord) rec = 64;
+    const std::size_t n = (mib << 20) / rec;
+
+    char path[] = "/tmp/spsc_replay_XXXXXX";
+    int fd = ::mkstemp(path);
+    {
+        std::vector<std::byte> chunk(rec * 4096);
+        for (std::size_t i = 0; i < n; i += 4096) {
+            const std::size_t k = std::min<std::size_t>(4096, n - i);
+            for (std::size_t j = 0; j < k; ++j) { std::uint64_t v = i + j; std::memcpy(chunk.data() + j * rec, &v, 8); }
+            if (::write(fd, chunk.data(), k * rec) < 0) return 1;
+        }
+    }
+    ::close(fd);
+
+    // read() 1 MiB at a time, copy each record into the ring slot
+    {
+        SPSC::SpscRing<Copied> ring(4096);
+        const auto t0 = std::chrono::steady_clock::now();
+        std::uint64_t sum = 0;
+        std::thread consumer([&] {
+            for (std::size_t got = 0; got < n;) {
+                if (Copied* c = ring.front()) { std::uint64_t v; std::memcpy(&v, c->bytes, 8); sum += v; ring.pop_front(); ++got; }
+                else std::this_thread::yield();
+            }
+        });
+        const int in = ::open(path, O_RDONLY);
+        std::vector<std::byte> buf((std::size_t{ 1 } << 20) / rec * rec);
+        for (ssize_t r; (r = ::read(in, buf.data(), buf.size())) > 0;) {
+            for (std::size_t off = 0; off + rec <= static_cast<std::size_t>(r); off += rec) {
+                Copied c;
+                c.size = static_cast<std::uint32_t>(rec);
+                std::memcpy(c.bytes, buf.data() + off, rec);
+                while (!ring.try_push(c)) std::this_thread::yield();
+            }
+        }
+        ::close(in);
+        consumer.join();
+        const double s = seconds(t0);
+        std::printf("read + copy     %8.0f MiB/s  %6.2f Mrec/s  (sum %llu)\n", static_cast<double>(mib) / s, static_cast<double>(n) / s / 1e6, static_cast<unsigned long long>(sum));
+    }
+
+    // MappedSource: views only
+    {
+        SPSC::SpscRing<SPSC::RecordView> ring(4096);
+        const auto t0 = std::chrono::steady_clock::now();
+        SPSC::MappedFile file(path);
+        SPSC::MappedSource<SPSC::Framing::Fixed> src(file, { rec });
+        std::uint64_t sum = 0;
+        std::thread consumer([&] {
+            for (std::size_t got = 0; got < n;) {
+                if (SPSC::RecordView* v = ring.front()) { std::uint64_t x; std::memcpy(&x, v->data, 8); sum += x; ring.pop_front(); ++got; }
+                else std::this_thread::yield();
+            }
+        });
+        src.run<SPSC::Wait::Yield>(ring, 256);
+        consumer.join();
+        const double s = seconds(t0);
+        std::printf("mmap views      %8.0f MiB/s  %6.2f Mrec/s  (sum %llu)\n", static_cast<double>(mib) / s, static_cast<double>(n) / s / 1e6, static_cast<unsigned long long>(sum));
+    }
+
+    ::unlink(path);
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Join-shortest-queue vs. round-robin under skewed worker speeds.
+// Build: g++ -std=c++20 -O2 -pthread -Iinclude bench/router_tail_latency.cpp -o router_bench
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "spsc_router.h"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Job
+    {
+        std::int64_t pushed_ns;
+    };
+
+    std::int64_t nowNs() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    // Busy work in ~ns units; keeps the worker on-CPU like a real handler
+    void spin(std::uint64_t iters) noexcept
+    {
+        for (std::uint64_t i = 0; i < iters; ++i) asm volatile("" ::: "memory");
+    }
+
+    template <class Router>
+    std::vector<std::int64_t> run(Router& router, const std::vector<std::uint64_t>& cost, std::uint64_t jobs)
+    {
+        const std::size_t n = router.rings();
+        std::atomic<bool> done{ false };
+        std::vector<std::vector<std::int64_t>> lat(n);
+        std::vector<std::thread> workers;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            lat[i].reserve(jobs);
+            workers.emplace_back([&, i] {
+                Job j{};
+                for (;;) {
+                    if (router.ring(i).try_pop(j)) {
+                        spin(cost[i]);
+                        lat[i].push_back(nowNs() - j.pushed_ns);
+                    } else if (done.load(std::memory_order_acquire)) {
+                        if (router.ring(i).empty()) break;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (std::uint64_t k = 0; k < jobs; ++k) {
+            while (router.push(Job{ nowNs() }) == router.rings()) std::this_thread::yield();
+            spin(200);  // offered load below aggregate capacity
+        }
+        done.store(true, std::memory_order_release);
+        for (auto& w : workers) w.join();
+
+        std::vector<std::int64_t> all;
+        for (auto& v : lat) all.insert(all.end(), v.begin(), v.end());
+        std::sort(all.begin(), all.end());
+        return all;
+    }
+
+    void report(const char* name, const std::vector<std::int64_t>& s)
+    {
+        auto q = [&](double p) { return s[static_cast<std::size_t>(p * static_cast<double>(s.size() - 1))]; };
+        std::printf("%-12s n=%zu  p50=%lld ns  p99=%lld ns  p99.9=%lld ns  max=%lld ns\n", name, s.size(),
+            static_cast<long long>(q(0.50)), static_cast<long long>(q(0.99)),
+            static_cast<long long>(q(0.999)), static_cast<long long>(s.back()));
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::uint64_t jobs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    // Worker 0 is 8x slower than the rest
+    const std::vector<std::uint64_t> cost{ 1600, 200, 200, 200 };
+
+    {
+        SPSC::RoundRobinRouter<Job> rr(cost.size(), 1024);
+        report("round-robin", run(rr, cost, jobs));
+    }
+    for (std::size_t refresh : { 1u, 16u, 256u }) {
+        SPSC::ShortestQueueRouter<Job> jsq(cost.size(), 1024, refresh);
+        char name[32];
+        std::snprintf(name, sizeof(name), "jsq/%zu", refresh);
+        report(name, run(jsq, cost, jobs));
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+// No-spill fast path: SpillRing::push/try_pop vs SpscRing::try_push/try_pop, same thread, bursts of 512.
+// Build: g++ -std=c++20 -O2 -pthread -Iinclude bench/spill_fast_path.cpp -o spill_bench
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "spsc_spill.h"
+
+namespace {
+    struct Tick
+    {
+        std::uint64_t seq;
+        std::uint64_t px;
+    };
+
+    constexpr std::uint64_t kBurst = 512;
+
+    template <class Push, class Pop>
+    double nsPerPair(std::uint64_t rounds, Push push, Pop pop)
+    {
+        std::uint64_t sum = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (std::uint64_t r = 0; r < rounds; ++r) {
+            for (std::uint64_t i = 0; i < kBurst; ++i) push(Tick{ i, r });
+            Tick t{};
+            for (std::uint64_t i = 0; i < kBurst; ++i) { pop(t); sum += t.seq; }
+        }
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        if (sum == 42) std::puts("");
+        return ns / static_cast<double>(rounds * kBurst);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::uint64_t rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 40000;
+
+    SPSC::SpscRing<Tick> ring(1024);
+    SPSC::SpillRing<Tick> spill(1024);
+
+    for (int rep = 0; rep < 3; ++rep) {
+        const double a = nsPerPair(rounds, [&](const Tick& t) { ring.try_push(t); }, [&](Tick& t) { ring.try_pop(t); });
+        const double b = nsPerPair(rounds, [&](const Tick& t) { spill.push(t); }, [&](Tick& t) { spill.try_pop(t); });
+        std::printf("SpscRing %.2f ns  SpillRing %.2f ns  (push + pop)%s\n", a, b, spill.spilled() ? "  [spilled!]" : "");
+    }
+    return 0;
+}
@@ -0,0 +1,469 @@
+// Reference market-data pipeline: feed -> [SpscRing] -> decoder/books -> [SpscRing] -> strategy
+//
+//   g++ -std=c++20 -O2 -pthread -Iinclude examples/market_data.cpp -o market_data
+//   ./market_data msgs=5000000 symbols=64 ring=4096 batch=1 rate=0 burst=1 wait=yield cpus=1,2,3
+//
+// Feed:      synthetic ITCH 5.0-style binary messages (Add/Execute/Cancel/Delete, big-endian
+//            fields), stamped with a steady_clock "wire" time as they are pushed; bids rest
+//            below a random-walking mid and asks above it, and before the mid steps onto a
+//            resting level those orders are executed, so the book never crosses
+// Decoder:   parses each message, maintains one price-level book per symbol and forwards a
+//            BookUpdate whenever a top of book changes; a crossed or locked result is counted
+//            and not forwarded
+// Strategy:  consumes updates (imbalance signal) and records wire-to-strategy latency
+//
+// Knobs: ring capacity, batch (staged publication on both producers), pacing (rate msgs/s with
+// bursts of `burst` back-to-back messages; 0 = flat out), wait strategy, and per-stage pinning.
+// Run it before/after a ring change to see the effect under a realistic access pattern.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "spsc_pipeline.h"  // pinThread
+#include "spsc_ring.h"
+#include "spsc_wait.h"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    std::uint64_t nowNs() noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+    }
+
+    // ------------------------ Wire format (ITCH 5.0 subset) ------------------------
+
+    constexpr std::size_t kAddLen = 36, kExecLen = 31, kCancelLen = 23, kDeleteLen = 19;
+
+    struct Packet final
+    {
+        std::uint64_t wire_ns;
+        std::uint16_t len;
+        std::uint8_t data[54];
+    };
+    static_assert(sizeof(Packet) == 64);
+
+    template <std::size_t N>
+    void putBe(std::uint8_t* p, std::uint64_t v) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * (N - 1 - i)));
+    }
+
+    template <std::size_t N>
+    std::uint64_t getBe(const std::uint8_t* p) noexcept
+    {
+        std::uint64_t v = 0;
+        for (std::size_t i = 0; i < N; ++i) v = (v << 8) | p[i];
+        return v;
+    }
+
+    // ------------------------ Stage messages ------------------------
+
+    struct BookUpdate final
+    {
+        std::uint64_t wire_ns;
+        std::uint32_t symbol;
+        std::uint32_t bid_px, bid_qty;
+        std::uint32_t ask_px, ask_qty;
+    };
+
+    constexpr std::uint32_t kTick = 100;            // ITCH prices are 1/10000 dollars: one cent
+    constexpr std::uint32_t kLevels = 4096;
+
+    // ------------------------ Feed generator ------------------------
+
+    class Feed final
+    {
+        struct Live final
+        {
+            std::uint64_t ref;
+            std::uint32_t shares;
+            std::uint32_t level;
+            bool buy;
+        };
+
+    public:
+        explicit Feed(std::uint32_t symbols)
+            : mid_(symbols, kLevels / 2), target_(symbols, kLevels / 2), live_(symbols) {}
+
+        // Next message into p (everything except wire_ns).
+        // Invariant per symbol: every live bid level < mid_ < every live ask level
+        void next(Packet& p) noexcept
+        {
+            const std::uint32_t sym = static_cast<std::uint32_t>(rand() % mid_.size());
+            std::vector<Live>& live = live_[sym];
+            const std::uint64_t roll = rand() % 100;
+            std::uint8_t* d = p.data;
+
+            // A pending mid move first trades through the orders resting on the new mid
+            if (target_[sym] != mid_[sym]) {
+                if (sweep(p, sym, live)) return;
+                mid_[sym] = target_[sym];
+            }
+
+            if (live.size() < 16 || roll < 50 || live.size() > 256) {
+                if (live.size() > 256) { remove(p, sym, live); return; }
+                // Add: side, price a few ticks off a random-walking mid
+                if (rand() % 8 == 0) {
+                    const std::uint32_t to = mid_[sym] + (rand() % 2 ? 1u : -1u);
+                    target_[sym] = std::clamp<std::uint32_t>(to, kLevels / 4, 3 * kLevels / 4);
+                }
+                const bool buy = rand() % 2;
+                // Depth thins out geometrically away from the touch
+                const std::uint32_t off = 1 + std::min<std::uint32_t>(static_cast<std::uint32_t>(std::countr_zero(rand() | (1ull << 15))), 15);
+                const std::uint32_t level = buy ? mid_[sym] - off : mid_[sym] + off;
+                const std::uint32_t px = level * kTick;
+                const std::uint32_t shares = 100 * (1 + static_cast<std::uint32_t>(rand() % 10));
+                const std::uint64_t ref = ++next_ref_;
+                d[0] = 'A';
+                header(d, sym);
+                putBe<8>(d + 11, ref);
+                d[19] = buy ? 'B' : 'S';
+                putBe<4>(d + 20, shares);
+                std::memcpy(d + 24, "SYM     ", 8);
+                putBe<4>(d + 32, px);
+                p.len = kAddLen;
+                live.push_back({ ref, shares, level, buy });
+                return;
+            }
+            remove(p, sym, live);
+        }
+
+        std::uint64_t sweeps() const noexcept { return sweeps_; }
+
+    private:
+        void header(std::uint8_t* d, std::uint32_t sym) noexcept
+        {
+            putBe<2>(d + 1, sym);          // stock locate = symbol index
+            putBe<2>(d + 3, 0);
+            putBe<6>(d + 5, ++clock_);
+        }
+
+        // Execute in full one live order of sym at or through target_; false once none is left
+        bool sweep(Packet& p, std::uint32_t sym, std::vector<Live>& live) noexcept
+        {
+            const std::uint32_t to = target_[sym];
+            for (std::size_t i = 0; i < live.size(); ++i) {
+                const Live o = live[i];
+                if (o.buy ? o.level < to : o.level > to) continue;
+                std::uint8_t* d = p.data;
+                d[0] = 'E';
+                header(d, sym);
+                putBe<8>(d + 11, o.ref);
+                putBe<4>(d + 19, o.shares);
+                putBe<8>(d + 23, ++match_);
+                p.len = kExecLen;
+                live[i] = live.back();
+                live.pop_back();
+                ++sweeps_;
+                return true;
+            }
+            return false;
+        }
+
+        // Execute, cancel or delete a random live order of sym
+        void remove(Packet& p, std::uint32_t sym, std::vector<Live>& live) noexcept
+        {
+            std::uint8_t* d = p.data;
+            const std::size_t i = static_cast<std::size_t>(rand() % live.size());
+            Live& o = live[i];
+            const std::uint64_t roll = rand() % 3;
+            const std::uint32_t part = std::min<std::uint32_t>(o.shares, 100);
+            header(d, sym);
+            putBe<8>(d + 11, o.ref);
+            if (roll == 0 && o.shares > part) {
+                d[0] = 'E';
+                putBe<4>(d + 19, part);
+                putBe<8>(d + 23, ++match_);
+                p.len = kExecLen;
+                o.shares -= part;
+            } else if (roll == 1 && o.shares > part) {
+                d[0] = 'X';
+                putBe<4>(d + 19, part);
+                p.len = kCancelLen;
+                o.shares -= part;
+            } else {
+                d[0] = 'D';
+                p.len = kDeleteLen;
+                o = live.back();
+                live.pop_back();
+            }
+        }
+
+        std::uint64_t rand() noexcept
+        {
+            seed_ ^= seed_ << 13;
+            seed_ ^= seed_ >> 7;
+            seed_ ^= seed_ << 17;
+            return seed_;
+        }
+
+        std::vector<std::uint32_t> mid_;
+        std::vector<std::uint32_t> target_;                 // mid_ once the sweep is done
+        std::vector<std::vector<Live>> live_;
+        std::uint64_t next_ref_{ 0 };
+        std::uint64_t clock_{ 0 };
+        std::uint64_t match_{ 0 };
+        std::uint64_t sweeps_{ 0 };
+        std::uint64_t seed_{ 0x9e3779b97f4a7c15ull };
+    };
+
+    // ------------------------ Decoder + books ------------------------
+
+    class Books final
+    {
+        struct Order final
+        {
+            std::uint32_t symbol;
+            std::uint32_t level;
+            std::uint32_t shares;
+            bool buy;
+        };
+
+        struct Book final
+        {
+            std::array<std::uint32_t, kLevels> bid{};
+            std::array<std::uint32_t, kLevels> ask{};
+            std::uint32_t best_bid{ 0 };            // level index; 0 = empty side
+            std::uint32_t best_ask{ kLevels };      // kLevels = empty side
+        };
+
+    public:
+        Books(std::uint32_t symbols, std::size_t orders) : books_(symbols) { orders_.reserve(orders); }
+
+        // Apply one wire message; true when sym's top of book changed (u filled in).
+        // A crossed or locked top is counted in crossed() and never forwarded
+        bool apply(const Packet& p, BookUpdate& u) noexcept
+        {
+            const std::uint8_t* d = p.data;
+            const auto sym = static_cast<std::uint32_t>(getBe<2>(d + 1));
+            const std::uint64_t ref = getBe<8>(d + 11);
+            Book& b = books_[sym];
+            const std::uint32_t bb = b.best_bid, ba = b.best_ask;
+            const std::uint32_t bq = bb ? b.bid[bb] : 0, aq = ba < kLevels ? b.ask[ba] : 0;
+
+            switch (d[0]) {
+                case 'A': {
+                    const auto level = static_cast<std::uint32_t>(getBe<4>(d + 32) / kTick);
+                    const auto shares = static_cast<std::uint32_t>(getBe<4>(d + 20));
+                    const bool buy = d[19] == 'B';
+                    if (orders_.size() <= ref) orders_.resize(ref + 1);
+                    orders_[ref] = { sym, level, shares, buy };
+                    if (buy) { b.bid[level] += shares; b.best_bid = std::max(b.best_bid, level); }
+                    else { b.ask[level] += shares; b.best_ask = std::min(b.best_ask, level); }
+                    break;
+                }
+                case 'E':
+                case 'X':
+                    reduce(b, orders_[ref], static_cast<std::uint32_t>(getBe<4>(d + 19)));
+                    break;
+                case 'D':
+                    reduce(b, orders_[ref], orders_[ref].shares);
+                    break;
+                default:
+                    return false;
+            }
+
+            if (b.best_bid && b.best_ask < kLevels && b.best_bid >= b.best_ask) { ++crossed_; return false; }
+            const std::uint32_t nbq = b.best_bid ? b.bid[b.best_bid] : 0;
+            const std::uint32_t naq = b.best_ask < kLevels ? b.ask[b.best_ask] : 0;
+            if (b.best_bid == bb && b.best_ask == ba && nbq == bq && naq == aq) return false;
+            u = { p.wire_ns, sym, b.best_bid * kTick, nbq, b.best_ask * kTick, naq };
+            return true;
+        }
+
+        std::uint64_t crossed() const noexcept { return crossed_; }
+
+    private:
+        static void reduce(Book& b, Order& o, std::uint32_t shares) noexcept
+        {
+            shares = std::min(shares, o.shares);
+            o.shares -= shares;
+            if (o.buy) {
+                b.bid[o.level] -= shares;
+                if (o.level == b.best_bid) while (b.best_bid && !b.bid[b.best_bid]) --b.best_bid;
+            } else {
+                b.ask[o.level] -= shares;
+                if (o.level == b.best_ask) while (b.best_ask < kLevels && !b.ask[b.best_ask]) ++b.best_ask;
+            }
+        }
+
+        std::vector<Book> books_;
+        std::vector<Order> orders_;
+        std::uint64_t crossed_{ 0 };
+    };
+
+    // ------------------------ Run ------------------------
+
+    struct Config final
+    {
+        std::uint64_t msgs{ 2'000'000 };
+        std::uint32_t symbols{ 64 };
+        std::size_t ring{ 4096 };
+        std::size_t batch{ 1 };
+        std::uint64_t rate{ 0 };            // msgs/s, 0 = flat out
+        std::uint64_t burst{ 1 };
+        std::string wait{ "yield" };
+        std::vector<int> cpus{};            // feed, decoder, strategy
+    };
+
+    // Staged push with publication every `batch` elements (batch 1 = plain try_push)
+    template <class T, class Wait>
+    void stagePush(SPSC::SpscRing<T>& ring, const T& v, std::size_t batch, std::size_t& staged, Wait& wait)
+    {
+        while (!ring.try_stage(v)) { ring.publish(); staged = 0; wait.wait(); }
+        wait.reset();
+        if (++staged >= batch) { ring.publish(); staged = 0; }
+    }
+
+    template <class Wait>
+    void run(const Config& cfg)
+    {
+        SPSC::SpscRing<Packet> wire(cfg.ring);
+        SPSC::SpscRing<BookUpdate> updates(cfg.ring);
+        std::atomic<bool> fed{ false }, decoded{ false };
+        std::vector<std::uint32_t> lat;
+        lat.reserve(cfg.msgs);
+        std::uint64_t signals = 0, update_count = 0, crossed = 0, sweeps = 0;
+
+        const auto t0 = Clock::now();
+
+        std::thread strategy([&] {
+            Wait wait{};
+            double last = 0;
+            for (;;) {
+                BookUpdate* u = updates.front();
+                if (!u) {
+                    if (decoded.load(std::memory_order_acquire) && !updates.front()) break;
+                    wait.wait();
+                    continue;
+                }
+                wait.reset();
+                const std::uint64_t now = nowNs();
+                lat.push_back(static_cast<std::uint32_t>(std::min<std::uint64_t>(now - u->wire_ns, UINT32_MAX)));
+                const double imb = (static_cast<double>(u->bid_qty) - u->ask_qty) / (static_cast<double>(u->bid_qty) + u->ask_qty + 1);
+                if ((imb > 0.6 && last <= 0.6) || (imb < -0.6 && last >= -0.6)) ++signals;
+                last = imb;
+                ++update_count;
+                updates.pop_front();
+            }
+        });
+
+        std::thread decoder([&] {
+            Books books(cfg.symbols, cfg.msgs / 2 + 1);
+            Wait wait{};
+            std::size_t staged = 0;
+            for (;;) {
+                Packet* p = wire.front();
+                if (!p) {
+                    updates.publish();
+                    staged = 0;
+                    if (fed.load(std::memory_order_acquire) && !wire.front()) break;
+                    wait.wait();
+                    continue;
+                }
+                BookUpdate u;
+                if (books.apply(*p, u)) stagePush(updates, u, cfg.batch, staged, wait);
+                wire.pop_front();
+            }
+            updates.publish();
+            crossed = books.crossed();
+            decoded.store(true, std::memory_order_release);
+        });
+
+        std::thread feed([&] {
+            Feed gen(cfg.symbols);
+            Wait wait{};
+            std::size_t staged = 0;
+            const std::uint64_t gap = cfg.rate ? 1'000'000'000ull * cfg.burst / cfg.rate : 0;
+            std::uint64_t due = nowNs();
+            Packet p{};
+            for (std::uint64_t i = 0; i < cfg.msgs; ++i) {
+                if (gap && i % cfg.burst == 0) {
+                    wire.publish();
+                    staged = 0;
+                    while (nowNs() < due) SPSC::Wait::cpuRelax();
+                    due += gap;
+                }
+                gen.next(p);
+                p.wire_ns = nowNs();
+                stagePush(wire, p, cfg.batch, staged, wait);
+            }
+            sweeps = gen.sweeps();
+            wire.publish();
+            fed.store(true, std::memory_order_release);
+        });
+
+        for (std::size_t i = 0; i < cfg.cpus.size() && i < 3; ++i) {
+            if (cfg.cpus[i] < 0) continue;
+            std::thread& t = i == 0 ? feed : i == 1 ? decoder : strategy;
+            SPSC::pinThread(t.native_handle(), cfg.cpus[i]);
+        }
+
+        feed.join();
+        decoder.join();
+        strategy.join();
+        const double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+        std::sort(lat.begin(), lat.end());
+        auto pct = [&](double q) { return lat.empty() ? 0u : lat[std::min(lat.size() - 1, static_cast<std::size_t>(q * static_cast<double>(lat.size())))]; };
+        std::printf("msgs %llu  symbols %u  ring %zu  batch %zu  rate %llu/s  burst %llu  wait %s\n",
+            static_cast<unsigned long long>(cfg.msgs), cfg.symbols, cfg.ring, cfg.batch,
+            static_cast<unsigned long long>(cfg.rate), static_cast<unsigned long long>(cfg.burst), cfg.wait.c_str());
+        std::printf("throughput  %.2f Mmsg/s  (%.3f s)   book updates %llu   signals %llu\n",
+            static_cast<double>(cfg.msgs) / secs / 1e6, secs,
+            static_cast<unsigned long long>(update_count), static_cast<unsigned long long>(signals));
+        std::printf("sweep executions %llu   crossed books rejected %llu\n",
+            static_cast<unsigned long long>(sweeps), static_cast<unsigned long long>(crossed));
+        std::printf("wire->strategy ns  p50 %u  p90 %u  p99 %u  p99.9 %u  p99.99 %u  max %u\n",
+            pct(0.50), pct(0.90), pct(0.99), pct(0.999), pct(0.9999), lat.empty() ? 0u : lat.back());
+    }
+
+    Config parse(int argc, char** argv)
+    {
+        Config c;
+        for (int i = 1; i < argc; ++i) {
+            std::string_view a(argv[i]);
+            const auto eq = a.find('=');
+            if (eq == std::string_view::npos) continue;
+            const std::string_view k = a.substr(0, eq);
+            const std::string v(a.substr(eq + 1));
+            if (k == "msgs") c.msgs = std::strtoull(v.c_str(), nullptr, 10);
+            else if (k == "symbols") c.symbols = static_cast<std::uint32_t>(std::max(1ul, std::strtoul(v.c_str(), nullptr, 10)));
+            else if (k == "ring") c.ring = std::strtoull(v.c_str(), nullptr, 10);
+            else if (k == "batch") c.batch = std::max<std::size_t>(1, std::strtoull(v.c_str(), nullptr, 10));
+            else if (k == "rate") c.rate = std::strtoull(v.c_str(), nullptr, 10);
+            else if (k == "burst") c.burst = std::max<std::uint64_t>(1, std::strtoull(v.c_str(), nullptr, 10));
+            else if (k == "wait") c.wait = v;
+            else if (k == "cpus") {
+                for (std::size_t pos = 0; pos <= v.size();) {
+                    std::size_t comma = v.find(',', pos);
+                    if (comma == std::string::npos) comma = v.size();
+                    c.cpus.push_back(std::atoi(v.substr(pos, comma - pos).c_str()));
+                    pos = comma + 1;
+                }
+            }
+        }
+        return c;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const Config cfg = parse(argc, argv);
+    if (cfg.wait == "spin") run<SPSC::Wait::SpinPause>(cfg);
+    else if (cfg.wait == "backoff") run<SPSC::Wait::Backoff>(cfg);
+    else run<SPSC::Wait::Yield>(cfg);
+    return 0;
+}
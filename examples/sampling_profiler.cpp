@@ -0,0 +1,223 @@
+// Always-on sampling profiler: SIGPROF handler -> per-thread SpscRing -> collector thread
+//
+//   g++ -std=c++20 -O2 -g -pthread -rdynamic -Iinclude examples/sampling_profiler.cpp -o profiler
+//
+// Every profiled thread owns one ring and its SIGPROF handler is that ring's only producer,
+// so try_push_signal_safe never races with another producer. The collector thread drains
+// all rings and aggregates identical stacks; symbols are resolved once, at report time.
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <execinfo.h>
+#include <sys/time.h>
+
+#include "spsc_ring.h"
+#include "spsc_wait.h"
+
+namespace {
+
+    constexpr int kMaxFrames = 32;
+    constexpr int kMaxThreads = 16;
+
+    struct Sample final
+    {
+        int frames{ 0 };
+        void* pcs[kMaxFrames];
+    };
+
+    struct alignas(64) ThreadSlot final
+    {
+        std::unique_ptr<SPSC::SpscRing<Sample>> owned;
+        std::atomic<SPSC::SpscRing<Sample>*> ring{ nullptr };     // published once the ring exists
+        std::atomic<std::uint64_t> dropped{ 0 };
+    };
+
+    ThreadSlot g_slots[kMaxThreads];
+    std::atomic<int> g_claimed{ 0 };
+    std::atomic<std::uint64_t> g_unregistered{ 0 };    // ticks landing on threads without a ring
+
+    thread_local ThreadSlot* t_slot = nullptr;
+
+    // Called once per profiled thread before it does real work
+    void registerThread(std::size_t ring_cap)
+    {
+        const int i = g_claimed.fetch_add(1, std::memory_order_relaxed);
+        if (i >= kMaxThreads) return;
+        g_slots[i].owned = std::make_unique<SPSC::SpscRing<Sample>>(ring_cap);
+        g_slots[i].ring.store(g_slots[i].owned.get(), std::memory_order_release);
+        t_slot = &g_slots[i];
+    }
+
+    extern "C" void onProf(int)
+    {
+        const int saved = errno;
+        ThreadSlot* slot = t_slot;
+        if (!slot) {
+            g_unregistered.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            Sample s;
+            // backtrace() is safe here once libgcc's unwinder is loaded (see warmUnwinder)
+            s.frames = ::backtrace(s.pcs, kMaxFrames);
+            if (!slot->owned->try_push_signal_safe(s)) slot->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        errno = saved;
+    }
+
+    // The first backtrace() call may dlopen libgcc_s and allocate; never let that happen in the handler
+    void warmUnwinder()
+    {
+        void* pcs[1];
+        ::backtrace(pcs, 1);
+    }
+
+    // ------------------------ Collector ------------------------
+
+    struct StackKey final
+    {
+        int frames;
+        void* pcs[kMaxFrames];
+
+        bool operator<(const StackKey& o) const noexcept
+        {
+            if (frames != o.frames) return frames < o.frames;
+            return std::memcmp(pcs, o.pcs, sizeof(void*) * static_cast<std::size_t>(frames)) < 0;
+        }
+    };
+
+    class Collector final
+    {
+    public:
+        // Collector Thread: one pass over every registered ring
+        std::size_t drain()
+        {
+            std::size_t n = 0;
+            const int threads = std::min(g_claimed.load(std::memory_order_relaxed), kMaxThreads);
+            for (int i = 0; i < threads; ++i) {
+                SPSC::SpscRing<Sample>* r = g_slots[i].ring.load(std::memory_order_acquire);
+                if (!r) continue;   // claimed, not yet published
+                SPSC::SpscRing<Sample>& ring = *r;
+                for (Sample* s; (s = ring.front()); ++n) {
+                    // Skip the handler and the sigreturn trampoline so stacks start at the interrupted pc
+                    StackKey k{ s->frames > 2 ? s->frames - 2 : 0, {} };
+                    std::memcpy(k.pcs, s->pcs + 2, sizeof(void*) * static_cast<std::size_t>(k.frames));
+                    ++stacks_[k];
+                    ring.pop_front();
+                }
+            }
+            total_ += n;
+            return n;
+        }
+
+        void report(std::size_t top) const
+        {
+            std::vector<std::pair<std::uint64_t, const StackKey*>> order;
+            order.reserve(stacks_.size());
+            for (const auto& [k, count] : stacks_) order.emplace_back(count, &k);
+            std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+            std::printf("%llu samples, %zu distinct stacks\n",
+                static_cast<unsigned long long>(total_), stacks_.size());
+            for (std::size_t i = 0; i < order.size() && i < top; ++i) {
+                const auto& [count, k] = order[i];
+                std::printf("\n%5.1f%%  (%llu)\n", 100.0 * static_cast<double>(count) / static_cast<double>(total_),
+                    static_cast<unsigned long long>(count));
+                char** names = ::backtrace_symbols(k->pcs, k->frames);
+                for (int f = 0; f < k->frames && f < 8; ++f) std::printf("        %s\n", names ? names[f] : "?");
+                std::free(names);
+            }
+        }
+
+    private:
+        std::map<StackKey, std::uint64_t> stacks_;
+        std::uint64_t total_{ 0 };
+    };
+
+    // ------------------------ Workload ------------------------
+
+    __attribute__((noinline)) double heavy(int n)
+    {
+        double acc = 0;
+        for (int i = 1; i < n; ++i) acc += std::sqrt(static_cast<double>(i)) * std::sin(i);
+        return acc;
+    }
+
+    __attribute__((noinline)) double light(int n)
+    {
+        double acc = 0;
+        for (int i = 1; i < n; ++i) acc += 1.0 / i;
+        return acc;
+    }
+
+    void worker(std::atomic<bool>& run, std::atomic<double>& sink)
+    {
+        registerThread(4096);
+        double acc = 0;
+        while (run.load(std::memory_order_relaxed)) acc += heavy(200000) + light(50000);
+        sink.store(acc, std::memory_order_relaxed);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int threads = argc > 1 ? std::atoi(argv[1]) : 2;
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 2;
+    const int hz = 1000;
+
+    warmUnwinder();
+
+    struct sigaction sa{};
+    sa.sa_handler = onProf;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGPROF, &sa, nullptr);
+
+    std::atomic<bool> run{ true };
+    std::atomic<double> sink{ 0 };
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i) pool.emplace_back(worker, std::ref(run), std::ref(sink));
+
+    // The collector is not profiled: a tick landing on it is only counted
+    Collector collector;
+    std::atomic<bool> collecting{ true };
+    std::thread drainer([&] {
+        SPSC::Wait::Backoff wait{};
+        while (collecting.load(std::memory_order_acquire)) {
+            if (collector.drain()) wait.reset();
+            else wait.wait();
+        }
+    });
+
+    itimerval tv{};
+    tv.it_interval.tv_usec = 1000000 / hz;
+    tv.it_value = tv.it_interval;
+    setitimer(ITIMER_PROF, &tv, nullptr);
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+    tv = {};
+    setitimer(ITIMER_PROF, &tv, nullptr);
+    run.store(false, std::memory_order_relaxed);
+    for (auto& t : pool) t.join();
+    collecting.store(false, std::memory_order_release);
+    drainer.join();
+    collector.drain();
+
+    std::uint64_t dropped = 0;
+    for (int i = 0; i < kMaxThreads; ++i) dropped += g_slots[i].dropped.load();
+    collector.report(5);
+    std::printf("\ndropped %llu, outside profiled threads %llu\n",
+        static_cast<unsigned long long>(dropped), static_cast<unsigned long long>(g_unregistered.load()));
+    return 0;
+}
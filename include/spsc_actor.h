@@ -0,0 +1,228 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "spsc_doorbell.h"
+#include "spsc_pipeline.h"  // pinThread
+#include "spsc_ring.h"
+#include "spsc_wait.h"
+
+namespace SPSC {
+
+    template <class A>
+    struct ActorRef final
+    {
+        A* actor{ nullptr };
+        std::uint32_t core{ 0 };
+    };
+
+    /**
+     * @BasicActorSystem:  actors pinned to cores, messaging over SPSC mailboxes only
+     * @endpoints:
+     * - cores 0..N-1 are scheduler threads; attach() gives other threads endpoint N..N+E-1
+     * - a thread finds its endpoint by the system's instance id, so it keeps one endpoint per
+     *   system it sends into, and a system rebuilt at a dead one's address starts with none
+     * - a mailbox is one SpscRing per (sending endpoint -> receiving core): the producer is the
+     *   one thread behind the endpoint and the consumer is the receiver's scheduler, so
+     *   actor-to-actor traffic never needs an MPSC queue
+     * - mailboxes are created lazily by the sender on first use and published with a release
+     *   store into the mailbox table; the receiver's doorbell tells it which ones to poll
+     * @send:
+     * - send<Msg>(to, args...) constructs Msg inside the ring slot (Envelope inline buffer)
+     * - the receiver calls to.actor->receive(Msg&) in place, then destroys the slot
+     * - false when the mailbox is full; the caller decides to retry or drop
+     * @actors:            spawn() before start(); owned by the system, destroyed with it
+     */
+    template <class Wait = Wait::Backoff, std::size_t InlineBytes = 48>
+    class BasicActorSystem final
+    {
+        struct Envelope final
+        {
+            using Invoke = void (*)(void* actor, void* msg);
+            using Destroy = void (*)(void* msg) noexcept;
+
+            Invoke invoke;
+            Destroy destroy;
+            void* actor;
+            alignas(std::max_align_t) std::byte buf[InlineBytes];
+
+            template <class A, class Msg, class... Args>
+            Envelope(A* to, std::in_place_type_t<Msg>, Args&&... args)
+                : invoke([](void* a, void* m) { static_cast<A*>(a)->receive(*std::launder(static_cast<Msg*>(m))); }),
+                  destroy([](void* m) noexcept { std::destroy_at(std::launder(static_cast<Msg*>(m))); }),
+                  actor(to)
+            {
+                std::construct_at(reinterpret_cast<Msg*>(buf), std::forward<Args>(args)...);
+            }
+
+            Envelope(const Envelope&) = delete;
+            Envelope& operator=(const Envelope&) = delete;
+
+            ~Envelope() { destroy(buf); }
+
+            void deliver() { invoke(actor, buf); }
+        };
+
+        using Mailbox = SpscRing<Envelope>;
+
+        // Endpoint index of the calling thread in each system it sends from
+        using Endpoints = Detail::ThreadRoles<BasicActorSystem, std::uint32_t>;
+
+        struct ActorHolder
+        {
+            virtual ~ActorHolder() = default;
+        };
+
+        template <class A>
+        struct Holder final : ActorHolder
+        {
+            template <class... Args>
+            explicit Holder(Args&&... args) : actor(std::forward<Args>(args)...) {}
+            A actor;
+        };
+
+    public:
+        struct Options final
+        {
+            std::size_t cores{ 1 };
+            std::size_t external{ 4 };      // threads allowed to attach() as senders
+            std::size_t mailbox_cap{ 1024 };
+            std::size_t budget{ 64 };       // messages per mailbox per scheduler pass
+            std::vector<int> cpus{};        // cpus[i] pins scheduler i; < 0 = not pinned
+        };
+
+        explicit BasicActorSystem(Options opt)
+            : opt_(std::move(opt)),
+              endpoints_(opt_.cores + opt_.external),
+              mailboxes_(std::make_unique<std::atomic<Mailbox*>[]>(endpoints_ * opt_.cores)),
+              owned_(endpoints_ * opt_.cores)
+        {
+            if (!opt_.cores) throw std::invalid_argument("BasicActorSystem: cores == 0");
+            doorbells_.reserve(opt_.cores);
+            actors_.resize(opt_.cores);
+            for (std::size_t c = 0; c < opt_.cores; ++c) doorbells_.push_back(std::make_unique<Doorbell>(endpoints_));
+        }
+
+        ~BasicActorSystem() { stop(); }
+
+        BasicActorSystem(const BasicActorSystem&) = delete;
+        BasicActorSystem& operator=(const BasicActorSystem&) = delete;
+
+        std::size_t cores() const noexcept { return opt_.cores; }
+
+        template <class A, class... Args>
+        ActorRef<A> spawn(std::size_t core, Args&&... args)
+        {
+            auto h = std::make_unique<Holder<A>>(std::forward<Args>(args)...);
+            ActorRef<A> ref{ &h->actor, static_cast<std::uint32_t>(core) };
+            actors_[core].push_back(std::move(h));
+            return ref;
+        }
+
+        // Claim a sender endpoint for the calling (non-scheduler) thread
+        void attach() { (void)endpoint(); }
+
+        template <class Msg, class A, class... Args>
+        bool send(ActorRef<A> to, Args&&... args)
+        {
+            static_assert(sizeof(Msg) <= InlineBytes, "message does not fit the envelope");
+            static_assert(alignof(Msg) <= alignof(std::max_align_t), "over-aligned message");
+
+            const std::uint32_t* ep = Endpoints::find(id_);
+            const std::size_t from = ep ? *ep : endpoint();
+            Mailbox& mb = mailbox(from, to.core);
+            if (!mb.try_emplace(to.actor, std::in_place_type<Msg>, std::forward<Args>(args)...)) return false;
+            doorbells_[to.core]->ring(from);
+            return true;
+        }
+
+        void start()
+        {
+            threads_.reserve(opt_.cores);
+            for (std::size_t c = 0; c < opt_.cores; ++c)
+                threads_.emplace_back([this, c](std::stop_token st) { run(c, st); });
+            for (std::size_t c = 0; c < opt_.cores && c < opt_.cpus.size(); ++c)
+                if (opt_.cpus[c] >= 0) pinThread(threads_[c].native_handle(), opt_.cpus[c]);
+        }
+
+        void stop()
+        {
+            for (auto& t : threads_) t.request_stop();
+            for (auto& t : threads_) if (t.joinable()) t.join();
+            threads_.clear();
+        }
+
+    private:
+        // The calling thread's endpoint in this system, claimed on first use
+        std::uint32_t endpoint()
+        {
+            if (const std::uint32_t* ep = Endpoints::find(id_)) return *ep;
+            const std::uint32_t idx = next_external_.fetch_add(1, std::memory_order_relaxed);
+            if (idx >= opt_.external) throw std::runtime_error("BasicActorSystem: too many attached threads");
+            return Endpoints::add(id_, static_cast<std::uint32_t>(opt_.cores) + idx);
+        }
+
+        // Sender side: the only writer of this table entry is the endpoint's own thread
+        Mailbox& mailbox(std::size_t from, std::size_t to)
+        {
+            const std::size_t k = from * opt_.cores + to;
+            Mailbox* mb = mailboxes_[k].load(std::memory_order_relaxed);
+            if (!mb) {
+                owned_[k] = std::make_unique<Mailbox>(opt_.mailbox_cap);
+                mb = owned_[k].get();
+                mailboxes_[k].store(mb, std::memory_order_release);
+            }
+            return *mb;
+        }
+
+        void run(std::size_t core, std::stop_token st)
+        {
+            Endpoints::add(id_, static_cast<std::uint32_t>(core));
+            Doorbell& bell = *doorbells_[core];
+            Wait wait{};
+
+            while (!st.stop_requested()) {
+                bool progress = false;
+                for (std::size_t w = 0; w < bell.words(); ++w) {
+                    for (std::uint64_t bits = bell.take(w); bits; bits &= bits - 1) {
+                        const std::size_t from = w * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                        Mailbox* mb = mailboxes_[from * opt_.cores + core].load(std::memory_order_acquire);
+                        std::size_t n = 0;
+                        for (Envelope* e; n < opt_.budget && (e = mb->front()); ++n) {
+                            e->deliver();
+                            mb->pop_front();
+                        }
+                        // Budget spent with mail left: keep the mailbox in the active set
+                        if (n == opt_.budget && mb->front()) bell.ring(from);
+                        progress |= n != 0;
+                    }
+                }
+                if (progress) wait.reset();
+                else wait.wait();
+            }
+        }
+
+        const std::uint64_t id_{ Detail::nextInstanceId() };
+        Options opt_;
+        std::size_t endpoints_;
+        std::unique_ptr<std::atomic<Mailbox*>[]> mailboxes_;    // [from * cores + to]
+        std::vector<std::unique_ptr<Mailbox>> owned_;
+        std::vector<std::unique_ptr<Doorbell>> doorbells_;
+        std::vector<std::vector<std::unique_ptr<ActorHolder>>> actors_;
+        std::atomic<std::uint32_t> next_external_{ 0 };
+        std::vector<std::jthread> threads_;
+    };
+
+    using ActorSystem = BasicActorSystem<>;
+
+} // namespace SPSC
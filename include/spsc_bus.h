@@ -0,0 +1,274 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "spsc_ring.h"
+#include "spsc_wait.h"
+
+namespace SPSC {
+
+    enum class SlowPolicy : std::uint8_t
+    {
+        Drop,       // full lane: count it and move on
+        Conflate,   // full lane: keep only the newest value in a side slot, delivered once there is room
+        Block       // full lane: the publisher waits (until the lane drains or is unsubscribed)
+    };
+
+    /**
+     * @TopicBus:      in-process pub/sub; every (topic, subscriber) pair is its own SpscRing lane
+     * @publish:       load the topic's subscriber list (one acquire), push into each lane, then
+     *                 store the list version as seen (one release); no lock, no RMW
+     * @subscribe:
+     * - subscribe/unsubscribe copy the list, add/remove one lane and swap the pointer (RCU);
+     *   control calls serialize on a mutex the publish path never touches
+     * - a replaced list (and a removed lane) is retired and freed by reclaim() once the
+     *   topic's publisher has reported a newer version (quiescent-state based reclamation);
+     *   subscribe/unsubscribe also reclaim whatever has become free
+     * - only publish()/flush() report a version: retired entries of a topic whose publisher has
+     *   gone idle stay allocated until it publishes or calls flush(topic) again
+     * @policies:      per subscriber, so one slow reader never stalls the others unless it asked
+     *                 for Block
+     * @Wait:          how a publisher waits on a full Block lane
+     * @threads:       one publisher thread per topic; each Subscription is read by one thread;
+     *                 subscribe/unsubscribe/reclaim from any thread
+     */
+    template <class T, class Wait = Wait::Backoff>
+    class TopicBus final
+    {
+        struct Lane final
+        {
+            Lane(std::size_t cap, SlowPolicy p) : ring(cap), policy(p) {}
+
+            SpscRing<T> ring;
+            SlowPolicy policy;
+            std::atomic<bool> closed{ false };
+            alignas(64) std::optional<T> side{};        // Conflate: publisher-private
+            std::atomic<std::uint64_t> dropped{ 0 };
+            std::atomic<std::uint64_t> conflated{ 0 };
+        };
+
+        struct List final
+        {
+            std::uint64_t version{ 0 };
+            std::vector<Lane*> lanes{};
+        };
+
+        struct Retired final
+        {
+            std::size_t topic;
+            std::uint64_t until;                        // free once seen >= until
+            std::unique_ptr<const List> list;
+            std::shared_ptr<Lane> lane;
+        };
+
+        struct alignas(64) Topic final
+        {
+            std::atomic<const List*> list{ nullptr };
+            alignas(64) std::atomic<std::uint64_t> seen{ 0 };     // publisher: last list version used
+            // control side
+            std::unique_ptr<const List> owned{};
+            std::vector<std::shared_ptr<Lane>> lanes{};
+        };
+
+    public:
+        class Subscription final
+        {
+        public:
+            Subscription() = default;
+            Subscription(Subscription&& o) noexcept
+                : bus_(std::exchange(o.bus_, nullptr)), topic_(o.topic_), lane_(std::move(o.lane_)) {}
+            Subscription& operator=(Subscription&& o) noexcept
+            {
+                if (this != &o) {
+                    reset();
+                    bus_ = std::exchange(o.bus_, nullptr);
+                    topic_ = o.topic_;
+                    lane_ = std::move(o.lane_);
+                }
+                return *this;
+            }
+            ~Subscription() { reset(); }
+
+            explicit operator bool() const noexcept { return bus_ != nullptr; }
+            std::size_t topic() const noexcept { return topic_; }
+
+            // An empty (reset or moved-from) subscription reads as an empty lane
+            bool try_pop(T& out) noexcept { return lane_ && lane_->ring.try_pop(out); }
+            T* front() noexcept { return lane_ ? lane_->ring.front() : nullptr; }
+
+            // Pre-condition: front() returned non-null
+            void pop_front() noexcept
+            {
+                assert(lane_);
+                lane_->ring.pop_front();
+            }
+
+            std::uint64_t dropped() const noexcept { return lane_ ? lane_->dropped.load(std::memory_order_relaxed) : 0; }
+            std::uint64_t conflated() const noexcept { return lane_ ? lane_->conflated.load(std::memory_order_relaxed) : 0; }
+
+            // Leave the topic; pending messages are discarded
+            void reset()
+            {
+                if (bus_) std::exchange(bus_, nullptr)->remove(topic_, lane_);
+                lane_.reset();
+            }
+
+        private:
+            friend class TopicBus;
+            Subscription(TopicBus* bus, std::size_t topic, std::shared_ptr<Lane> lane)
+                : bus_(bus), topic_(topic), lane_(std::move(lane)) {}
+
+            TopicBus* bus_{ nullptr };
+            std::size_t topic_{ 0 };
+            std::shared_ptr<Lane> lane_{};
+        };
+
+        explicit TopicBus(std::size_t topics) : topics_(std::make_unique<Topic[]>(topics)), n_(topics)
+        {
+            for (std::size_t t = 0; t < n_; ++t) {
+                topics_[t].owned = std::make_unique<const List>();
+                topics_[t].list.store(topics_[t].owned.get(), std::memory_order_release);
+            }
+        }
+
+        // Subscriptions must be gone (or reset) and publishers stopped
+        ~TopicBus() = default;
+
+        TopicBus(const TopicBus&) = delete;
+        TopicBus& operator=(const TopicBus&) = delete;
+
+        std::size_t topics() const noexcept { return n_; }
+
+        Subscription subscribe(std::size_t topic, SlowPolicy policy = SlowPolicy::Drop, std::size_t cap = 1024)
+        {
+            if (topic >= n_) throw std::out_of_range("TopicBus: topic");
+            auto lane = std::make_shared<Lane>(cap, policy);
+            std::lock_guard lock(ctl_);
+            Topic& t = topics_[topic];
+            auto next = std::make_unique<List>(*t.owned);
+            next->version = t.owned->version + 1;
+            next->lanes.push_back(lane.get());
+            t.lanes.push_back(lane);
+            swap(topic, std::move(next), nullptr);
+            return Subscription(this, topic, std::move(lane));
+        }
+
+        std::size_t subscribers(std::size_t topic) const noexcept
+        {
+            return topics_[topic].list.load(std::memory_order_acquire)->lanes.size();
+        }
+
+        // Publisher Thread (one per topic): returns the number of lanes that accepted v
+        std::size_t publish(std::size_t topic, const T& v)
+        {
+            Topic& t = topics_[topic];
+            const List* l = t.list.load(std::memory_order_acquire);
+            std::size_t n = 0;
+            for (Lane* lane : l->lanes) n += deliver(*lane, v);
+            t.seen.store(l->version, std::memory_order_release);
+            return n;
+        }
+
+        // Publisher Thread: retry conflated values still parked in side slots (call when idle)
+        void flush(std::size_t topic)
+        {
+            Topic& t = topics_[topic];
+            const List* l = t.list.load(std::memory_order_acquire);
+            for (Lane* lane : l->lanes)
+                if (lane->side && lane->ring.try_push(std::move(*lane->side))) lane->side.reset();
+            t.seen.store(l->version, std::memory_order_release);
+        }
+
+        // Free retired lists/lanes whose topic publisher has moved past them; returns how many
+        std::size_t reclaim()
+        {
+            std::lock_guard lock(ctl_);
+            return reclaimLocked();
+        }
+
+        // Retired lists/lanes still waiting for their topic's publisher (see @subscribe)
+        std::size_t retired() const
+        {
+            std::lock_guard lock(ctl_);
+            return retired_.size();
+        }
+
+    private:
+        static bool deliver(Lane& lane, const T& v)
+        {
+            switch (lane.policy) {
+                case SlowPolicy::Drop:
+                    if (lane.ring.try_push(v)) return true;
+                    lane.dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                case SlowPolicy::Conflate:
+                    if (lane.side) {
+                        if (!lane.ring.try_push(std::move(*lane.side))) {
+                            lane.side = v;
+                            lane.conflated.fetch_add(1, std::memory_order_relaxed);
+                            return false;
+                        }
+                        lane.side.reset();
+                    }
+                    if (lane.ring.try_push(v)) return true;
+                    lane.side = v;
+                    return false;
+                case SlowPolicy::Block: {
+                    Wait wait{};
+                    while (!lane.ring.try_push(v)) {
+                        if (lane.closed.load(std::memory_order_acquire)) return false;
+                        wait.wait();
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void remove(std::size_t topic, const std::shared_ptr<Lane>& lane)
+        {
+            lane->closed.store(true, std::memory_order_release);     // releases a publisher blocked on it
+            std::lock_guard lock(ctl_);
+            Topic& t = topics_[topic];
+            auto next = std::make_unique<List>();
+            next->version = t.owned->version + 1;
+            for (Lane* l : t.owned->lanes) if (l != lane.get()) next->lanes.push_back(l);
+            std::erase(t.lanes, lane);
+            swap(topic, std::move(next), lane);
+        }
+
+        // ctl_ held: publish next, retire the old list (and a removed lane) until the publisher sees next
+        void swap(std::size_t topic, std::unique_ptr<List> next, std::shared_ptr<Lane> removed)
+        {
+            Topic& t = topics_[topic];
+            const std::uint64_t v = next->version;
+            t.list.store(next.get(), std::memory_order_release);
+            retired_.push_back(Retired{ topic, v, std::move(t.owned), std::move(removed) });
+            t.owned = std::move(next);
+            reclaimLocked();
+        }
+
+        std::size_t reclaimLocked()
+        {
+            const std::size_t before = retired_.size();
+            std::erase_if(retired_, [this](const Retired& r) {
+                return topics_[r.topic].seen.load(std::memory_order_acquire) >= r.until;
+            });
+            return before - retired_.size();
+        }
+
+        std::unique_ptr<Topic[]> topics_;
+        std::size_t n_;
+        mutable std::mutex ctl_;
+        std::vector<Retired> retired_;
+    };
+
+} // namespace SPSC
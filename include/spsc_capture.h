@@ -0,0 +1,255 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "spsc_ring.h"
+#include "spsc_sink.h"
+#include "spsc_source.h"   // MappedFile
+#include "spsc_wait.h"
+
+namespace SPSC {
+
+    /**
+     * @capture_format:    [CaptureHeader, 64 bytes][CaptureRecord<T>]...
+     * - ts: steady_clock nanoseconds at push; only differences are meaningful
+     * - value: raw bytes of T, so a capture is read back with the same T on the same ABI
+     * - record padding is written as zeros; padding inside T is whatever the recorded object held
+     * - lost: records the recorder had to drop, written when it closes; kLostUnknown until then,
+     *   so a capture cut short by a crash never reads as complete
+     */
+    struct alignas(64) CaptureHeader final
+    {
+        static constexpr char kMagic[8] = { 'S', 'P', 'S', 'C', 'C', 'A', 'P', '1' };
+        static constexpr std::uint32_t kVersion = 2;
+        static constexpr std::uint64_t kLostUnknown = ~std::uint64_t{ 0 };
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t elem_size;
+        std::uint32_t record_size;
+        std::uint32_t reserved;
+        std::uint64_t lost;
+    };
+
+    template <class T>
+    struct CaptureRecord final
+    {
+        std::uint64_t ts;
+        T value;
+
+        CaptureRecord() = default;
+
+        // Every record byte defined: the file never carries stack garbage between or after fields
+        CaptureRecord(std::uint64_t t, const T& v) noexcept
+        {
+            std::memset(static_cast<void*>(this), 0, sizeof(*this));
+            ts = t;
+            std::memcpy(static_cast<void*>(std::addressof(value)), std::addressof(v), sizeof(T));
+        }
+    };
+
+    inline std::uint64_t captureNow() noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @CaptureRecorder:   writes a capture file off the hot path
+     * - record() stamps the value and pushes it into a side ring; a FileSink thread drains that
+     *   ring with writev (no per-message write())
+     * - a full side ring makes record() wait for the writer (block_when_full, the default), so
+     *   bursts are captured whole; with it off the record is dropped, counted in lost() and the
+     *   count is stored in the file header on close
+     * @threads:           record() from one producer thread (the tapped ring's producer)
+     */
+    template <class T>
+        requires std::is_trivially_copyable_v<T>
+    class CaptureRecorder final
+    {
+        using Record = CaptureRecord<T>;
+
+    public:
+        struct Options final
+        {
+            std::size_t ring_cap{ 1 << 16 };
+            bool block_when_full{ true };       // false: drop on a full side ring (counted)
+            std::size_t sync_bytes{ 0 };        // FileSink group commit; 0 = fsync on close only
+        };
+
+        explicit CaptureRecorder(const char* path, Options opt = {})
+            : opt_(opt), side_(opt_.ring_cap)
+        {
+            fd_ = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd_ < 0) throw std::system_error(errno, std::system_category(), "CaptureRecorder: open");
+            struct Guard { int fd; bool armed; ~Guard() { if (armed) ::close(fd); } } guard{ fd_, true };   // closes fd_ if we throw
+            CaptureHeader h{};
+            std::memcpy(h.magic, CaptureHeader::kMagic, sizeof(h.magic));
+            h.version = CaptureHeader::kVersion;
+            h.elem_size = sizeof(T);
+            h.record_size = sizeof(Record);
+            h.lost = CaptureHeader::kLostUnknown;
+            if (::write(fd_, &h, sizeof(h)) != static_cast<ssize_t>(sizeof(h)))
+                throw std::system_error(errno, std::system_category(), "CaptureRecorder: header");
+            typename FileSink<Record>::Options so{};
+            so.sync_bytes = opt_.sync_bytes;
+            sink_ = std::make_unique<FileSink<Record>>(fd_, so);
+            writer_ = std::jthread([this](std::stop_token st) { sink_->run(side_, st); });
+            guard.armed = false;        // fully built: the destructor closes fd_ from here on
+        }
+
+        ~CaptureRecorder()
+        {
+            writer_.request_stop();
+            writer_.join();     // drains and fsyncs what is left
+            sink_.reset();
+            // The header's lost count marks the capture closed; best effort, a destructor cannot throw
+            const std::uint64_t lost = lost_.load(std::memory_order_relaxed);
+            if (::pwrite(fd_, &lost, sizeof(lost), offsetof(CaptureHeader, lost)) == static_cast<ssize_t>(sizeof(lost)))
+                ::fdatasync(fd_);
+            ::close(fd_);
+        }
+
+        CaptureRecorder(const CaptureRecorder&) = delete;
+        CaptureRecorder& operator=(const CaptureRecorder&) = delete;
+
+        // Producer Thread
+        void record(const T& v, std::uint64_t ts = captureNow())
+        {
+            if (side_.try_emplace(ts, v)) return;
+            if (!opt_.block_when_full) { lost_.fetch_add(1, std::memory_order_relaxed); return; }
+            Wait::Backoff wait{};
+            while (!side_.try_emplace(ts, v)) wait.wait();
+        }
+
+        std::uint64_t lost() const noexcept { return lost_.load(std::memory_order_relaxed); }
+
+    private:
+        Options opt_;
+        int fd_{ -1 };
+        SpscRing<Record> side_;
+        std::unique_ptr<FileSink<Record>> sink_;
+        std::atomic<std::uint64_t> lost_{ 0 };
+        std::jthread writer_;
+    };
+
+    // Producer-side tap: a successful push into the ring is also recorded, stamped at the push
+    template <class T>
+    class CaptureTap final
+    {
+    public:
+        CaptureTap(SpscRing<T>& ring, CaptureRecorder<T>& rec) noexcept : ring_(ring), rec_(rec) {}
+
+        bool try_push(const T& v)
+        {
+            const std::uint64_t ts = captureNow();
+            if (!ring_.try_push(v)) return false;
+            rec_.record(v, ts);
+            return true;
+        }
+
+        SpscRing<T>& ring() noexcept { return ring_; }
+
+    private:
+        SpscRing<T>& ring_;
+        CaptureRecorder<T>& rec_;
+    };
+
+    /**
+     * @CaptureReplayer:   re-injects a capture into a ring, reproducing its bursts and gaps
+     * - lost() / complete(): whether the recorder dropped records (or never closed the file)
+     * - speed 1.0: original pacing; N: N times faster; <= 0: as fast as the ring accepts
+     * - waits longer than ~200 us sleep, shorter ones spin; a full ring delays the record
+     *   (and everything after it, schedule is not re-based) and shows up in max_lag_ns()
+     * @threads:           replay() on the target ring's producer thread
+     */
+    template <class T>
+        requires std::is_trivially_copyable_v<T>
+    class CaptureReplayer final
+    {
+        using Record = CaptureRecord<T>;
+
+    public:
+        explicit CaptureReplayer(const char* path) : file_(path)
+        {
+            CaptureHeader h{};
+            if (file_.size() < sizeof(h)) throw std::invalid_argument("CaptureReplayer: not a capture");
+            std::memcpy(&h, file_.data(), sizeof(h));
+            if (std::memcmp(h.magic, CaptureHeader::kMagic, sizeof(h.magic)) != 0 || h.version != CaptureHeader::kVersion)
+                throw std::invalid_argument("CaptureReplayer: not a capture");
+            if (h.elem_size != sizeof(T) || h.record_size != sizeof(Record))
+                throw std::invalid_argument("CaptureReplayer: element type does not match");
+            count_ = (file_.size() - sizeof(h)) / sizeof(Record);
+            lost_ = h.lost;
+            file_.advise(0, file_.size(), MADV_SEQUENTIAL);
+        }
+
+        std::size_t size() const noexcept { return count_; }
+
+        // Records the recorder dropped (CaptureHeader::kLostUnknown: it never closed the file);
+        // replay() reproduces what was captured, so check complete() before trusting the gaps
+        std::uint64_t lost() const noexcept { return lost_; }
+        bool complete() const noexcept { return lost_ == 0; }
+
+        Record at(std::size_t i) const noexcept
+        {
+            Record r;
+            std::memcpy(&r, file_.data() + sizeof(CaptureHeader) + i * sizeof(Record), sizeof(Record));
+            return r;
+        }
+
+        // Capture span: last ts - first ts
+        std::uint64_t duration_ns() const noexcept { return count_ ? at(count_ - 1).ts - at(0).ts : 0; }
+
+        template <class Wait = Wait::SpinPause>
+        std::size_t replay(SpscRing<T>& ring, double speed = 1.0)
+        {
+            using Clock = std::chrono::steady_clock;
+            if (!count_) return 0;
+            const std::uint64_t ts0 = at(0).ts;
+            const Clock::time_point t0 = Clock::now();
+            Wait wait{};
+            max_lag_ = 0;
+
+            for (std::size_t i = 0; i < count_; ++i) {
+                const Record r = at(i);
+                if (speed > 0) {
+                    const auto due = t0 + std::chrono::nanoseconds(static_cast<std::int64_t>(static_cast<double>(r.ts - ts0) / speed));
+                    for (auto now = Clock::now(); now < due; now = Clock::now()) {
+                        if (due - now > std::chrono::microseconds(200)) std::this_thread::sleep_for(due - now - std::chrono::microseconds(100));
+                        else SPSC::Wait::cpuRelax();
+                    }
+                    while (!ring.try_push(r.value)) wait.wait();
+                    wait.reset();
+                    const auto lag = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - due).count();
+                    max_lag_ = std::max<std::uint64_t>(max_lag_, static_cast<std::uint64_t>(lag));
+                } else {
+                    while (!ring.try_push(r.value)) wait.wait();
+                    wait.reset();
+                }
+            }
+            return count_;
+        }
+
+        std::uint64_t max_lag_ns() const noexcept { return max_lag_; }
+
+    private:
+        MappedFile file_;
+        std::size_t count_{ 0 };
+        std::uint64_t lost_{ CaptureHeader::kLostUnknown };
+        std::uint64_t max_lag_{ 0 };
+    };
+
+} // namespace SPSC
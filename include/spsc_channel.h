@@ -0,0 +1,314 @@
+#pragma once
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    template <class T> class Producer;
+    template <class T> class Consumer;
+
+    namespace Detail {
+        template <class T>
+        struct ChannelSlot final
+        {
+            alignas(T) std::byte obj_buf[sizeof(T)];
+
+            T* raw() noexcept { return reinterpret_cast<T*>(obj_buf); }
+            T* obj() noexcept { return std::launder(reinterpret_cast<T*>(obj_buf)); }
+        };
+    }
+
+    /**
+     * @ChannelCore:   the shared half of a split ring: slots plus the two published indices
+     * - never used directly; makeChannel() hands out exactly one Producer and one Consumer
+     * - freed when the last of the two handles goes away; destroys whatever is still published
+     */
+    template <class T>
+    class ChannelCore final
+    {
+        using Slot = Detail::ChannelSlot<T>;
+
+    public:
+        explicit ChannelCore(std::size_t cap)
+            : cap_(BitOps::roundCap(cap)), buffer_(std::make_unique<Slot[]>(cap_)) {}
+
+        ~ChannelCore() noexcept
+        {
+            std::size_t h = head_.load(std::memory_order_relaxed);
+            const std::size_t t = tail_.load(std::memory_order_relaxed);
+            while (h != t) { std::destroy_at(buffer_[h].obj()); h = (h + 1) & (cap_ - 1); }
+        }
+
+        ChannelCore(const ChannelCore&) = delete;
+        ChannelCore& operator=(const ChannelCore&) = delete;
+
+        std::size_t capacity() const noexcept { return cap_; }
+
+    private:
+        friend class Producer<T>;
+        friend class Consumer<T>;
+
+        std::size_t cap_;
+        std::unique_ptr<Slot[]> buffer_;
+        alignas(64) std::atomic<std::size_t> head_{ 0 };
+        alignas(64) std::atomic<std::size_t> tail_{ 0 };
+        Detail::RoleBaton producer_role_{};
+        Detail::RoleBaton consumer_role_{};
+    };
+
+    /**
+     * @Producer:      the write end; move-only, so exactly one thread can hold it
+     * - owns the real tail (tail_ is only ever stored, never loaded) and its cached view of head
+     * - counters are plain fields on the handle's own cache line
+     * - staged elements not yet published when the handle dies are destroyed, never delivered
+     * @migration:     moving the handle into a new thread needs whatever ordering carried it
+     *                 there; handoff()/adopt(h) provide it when the handle is shared in place
+     */
+    template <class T>
+    class alignas(64) Producer final
+    {
+    public:
+        Producer() = default;
+        Producer(Producer&& o) noexcept
+            : core_(std::move(o.core_)), slots_(std::exchange(o.slots_, nullptr)), mask_(o.mask_), tail_(o.tail_),
+              published_(o.published_), head_cache_(o.head_cache_), pushed_(o.pushed_), rejected_(o.rejected_) {}
+        Producer& operator=(Producer&& o) noexcept
+        {
+            if (this != &o) {
+                discardStaged();
+                core_ = std::move(o.core_);
+                slots_ = std::exchange(o.slots_, nullptr);
+                mask_ = o.mask_;
+                tail_ = o.tail_;
+                published_ = o.published_;
+                head_cache_ = o.head_cache_;
+                pushed_ = o.pushed_;
+                rejected_ = o.rejected_;
+            }
+            return *this;
+        }
+        ~Producer() noexcept { discardStaged(); }
+
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+
+        explicit operator bool() const noexcept { return core_ != nullptr; }
+        std::size_t capacity() const noexcept { return mask_ + 1; }
+
+        bool try_push(const T& v) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        {
+            if (!try_stage(v)) return false;
+            publish();
+            return true;
+        }
+
+        bool try_push(T&& v) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (!try_stage(std::move(v))) return false;
+            publish();
+            return true;
+        }
+
+        template <class... Args>
+            requires std::constructible_from<T, Args...>
+        bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        {
+            if (!try_stage(std::forward<Args>(args)...)) return false;
+            publish();
+            return true;
+        }
+
+        // Construct at the local tail; invisible to the consumer until publish()
+        template <class... Args>
+            requires std::constructible_from<T, Args...>
+        bool try_stage(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        {
+            const std::size_t next = (tail_ + 1) & mask_;
+            if (next == head_cache_) {
+                head_cache_ = core_->head_.load(std::memory_order_acquire);
+                if (next == head_cache_) { ++rejected_; return false; }
+            }
+            std::construct_at(slots_[tail_].raw(), std::forward<Args>(args)...);
+            tail_ = next;
+            ++pushed_;
+            return true;
+        }
+
+        // One release store for everything staged; skipped when there is nothing new
+        void publish() noexcept
+        {
+            if (published_ == tail_) return;
+            core_->tail_.store(tail_, std::memory_order_release);
+            published_ = tail_;
+        }
+
+        std::size_t staged() const noexcept { return (tail_ - published_) & mask_; }
+        std::size_t size_hint() const noexcept { return (tail_ - head_cache_) & mask_; }  // upper bound, no cross-core read
+
+        std::uint64_t pushed() const noexcept { return pushed_; }
+        std::uint64_t rejected() const noexcept { return rejected_; }
+
+        // Migration when the handle stays put and the thread changes (see SpscRing::handoff_producer)
+        std::uint32_t handoff() noexcept { return core_->producer_role_.handoff(); }
+        bool try_adopt(std::uint32_t h) const noexcept { return core_->producer_role_.try_adopt(h); }
+        void adopt(std::uint32_t h) const noexcept { core_->producer_role_.adopt(h); }
+
+    private:
+        template <class U>
+        friend std::pair<Producer<U>, Consumer<U>> makeChannel(std::size_t cap);
+
+        explicit Producer(std::shared_ptr<ChannelCore<T>> core) noexcept
+            : core_(std::move(core)), slots_(core_->buffer_.get()), mask_(core_->cap_ - 1) {}
+
+        void discardStaged() noexcept
+        {
+            if (!core_) return;
+            for (std::size_t i = published_; i != tail_; i = (i + 1) & mask_) std::destroy_at(slots_[i].obj());
+            tail_ = published_;
+        }
+
+        using Slot = Detail::ChannelSlot<T>;
+
+        std::shared_ptr<ChannelCore<T>> core_{};
+        Slot* slots_{ nullptr };
+        std::size_t mask_{ 0 };
+        std::size_t tail_{ 0 };
+        std::size_t published_{ 0 };
+        std::size_t head_cache_{ 0 };
+        std::uint64_t pushed_{ 0 };
+        std::uint64_t rejected_{ 0 };
+    };
+
+    /**
+     * @Consumer:      the read end; move-only, so exactly one thread can hold it
+     * - owns the real head and a cached view of tail: tail_ is re-read only when the cache says
+     *   empty, so a burst of n pops costs one acquire load instead of n
+     * - consume(n) after front_at()/peeking releases n slots with one store
+     */
+    template <class T>
+    class alignas(64) Consumer final
+    {
+    public:
+        Consumer() = default;
+        Consumer(Consumer&& o) noexcept
+            : core_(std::move(o.core_)), slots_(std::exchange(o.slots_, nullptr)), mask_(o.mask_),
+              head_(o.head_), tail_cache_(o.tail_cache_), popped_(o.popped_), empty_polls_(o.empty_polls_) {}
+        Consumer& operator=(Consumer&& o) noexcept
+        {
+            if (this != &o) {
+                core_ = std::move(o.core_);
+                slots_ = std::exchange(o.slots_, nullptr);
+                mask_ = o.mask_;
+                head_ = o.head_;
+                tail_cache_ = o.tail_cache_;
+                popped_ = o.popped_;
+                empty_polls_ = o.empty_polls_;
+            }
+            return *this;
+        }
+        ~Consumer() = default;
+
+        Consumer(const Consumer&) = delete;
+        Consumer& operator=(const Consumer&) = delete;
+
+        explicit operator bool() const noexcept { return core_ != nullptr; }
+        std::size_t capacity() const noexcept { return mask_ + 1; }
+
+        bool try_pop(T& out) noexcept
+        {
+            T* v = front();
+            if (!v) return false;
+            out = std::move(*v);
+            pop_front();
+            return true;
+        }
+
+        // Head element in place (nullptr if empty); valid until pop_front()
+        T* front() noexcept
+        {
+            if (head_ == tail_cache_ && !refresh()) return nullptr;
+            return slots_[head_].obj();
+        }
+
+        void pop_front() noexcept
+        {
+            std::destroy_at(slots_[head_].obj());
+            head_ = (head_ + 1) & mask_;
+            core_->head_.store(head_, std::memory_order_release);
+            ++popped_;
+        }
+
+        // Readable elements as seen through the cache; refresh with available()
+        std::size_t size_hint() const noexcept { return (tail_cache_ - head_) & mask_; }
+
+        // Re-read tail_ and return how many elements can be read
+        std::size_t available() noexcept
+        {
+            tail_cache_ = core_->tail_.load(std::memory_order_acquire);
+            return size_hint();
+        }
+
+        // i-th readable element in place (pre-condition: i < size_hint())
+        T* front_at(std::size_t i) noexcept { return slots_[(head_ + i) & mask_].obj(); }
+
+        // Destroy n head elements and release them with one store (pre-condition: n <= size_hint())
+        void consume(std::size_t n) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                for (std::size_t i = 0; i < n; ++i) std::destroy_at(slots_[(head_ + i) & mask_].obj());
+            head_ = (head_ + n) & mask_;
+            core_->head_.store(head_, std::memory_order_release);
+            popped_ += n;
+        }
+
+        std::uint64_t popped() const noexcept { return popped_; }
+        std::uint64_t empty_polls() const noexcept { return empty_polls_; }
+
+        // Migration when the handle stays put and the thread changes (see SpscRing::handoff_consumer)
+        std::uint32_t handoff() noexcept { return core_->consumer_role_.handoff(); }
+        bool try_adopt(std::uint32_t h) const noexcept { return core_->consumer_role_.try_adopt(h); }
+        void adopt(std::uint32_t h) const noexcept { core_->consumer_role_.adopt(h); }
+
+    private:
+        template <class U>
+        friend std::pair<Producer<U>, Consumer<U>> makeChannel(std::size_t cap);
+
+        explicit Consumer(std::shared_ptr<ChannelCore<T>> core) noexcept
+            : core_(std::move(core)), slots_(core_->buffer_.get()), mask_(core_->cap_ - 1) {}
+
+        bool refresh() noexcept
+        {
+            tail_cache_ = core_->tail_.load(std::memory_order_acquire);
+            if (head_ != tail_cache_) return true;
+            ++empty_polls_;
+            return false;
+        }
+
+        using Slot = Detail::ChannelSlot<T>;
+
+        std::shared_ptr<ChannelCore<T>> core_{};
+        Slot* slots_{ nullptr };
+        std::size_t mask_{ 0 };
+        std::size_t head_{ 0 };
+        std::size_t tail_cache_{ 0 };
+        std::uint64_t popped_{ 0 };
+        std::uint64_t empty_polls_{ 0 };
+    };
+
+    // One ring, two ends: move the Producer into the writing thread and the Consumer into the reader
+    template <class T>
+    std::pair<Producer<T>, Consumer<T>> makeChannel(std::size_t cap)
+    {
+        auto core = std::make_shared<ChannelCore<T>>(cap);
+        return { Producer<T>(core), Consumer<T>(std::move(core)) };
+    }
+
+} // namespace SPSC
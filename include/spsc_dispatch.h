@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    /**
+     * @KeyedDispatcher:   one producer fanning out to N consumer lanes (one SpscRing each)
+     * @routing:           lane = reduce(mix(hash(key(msg))), N) -> same key, same lane -> per-key FIFO
+     * @publication:
+     * - push() only stages into the lane (no release store)
+     * - flush() publishes every dirty lane once; cost per burst is O(dirty lanes)
+     * - a lane is published early when its burst reaches max_burst or it runs out of room
+     * @threads:
+     * - push/flush: the single producer thread
+     * - lane(i).try_pop: consumer i only
+     */
+    template <class T, class KeyFn, class Hash = std::hash<std::decay_t<std::invoke_result_t<KeyFn, const T&>>>>
+    class KeyedDispatcher final
+    {
+        using Key = std::decay_t<std::invoke_result_t<KeyFn, const T&>>;
+
+        struct Lane final
+        {
+            std::unique_ptr<SpscRing<T>> ring;
+            std::size_t burst{ 0 };     // staged since the last publish (producer-private)
+            bool dirty{ false };        // queued in dirty_ until the next flush()
+        };
+
+    public:
+        explicit KeyedDispatcher(std::size_t lanes, std::size_t lane_cap,
+                                 KeyFn key = KeyFn{}, Hash hash = Hash{},
+                                 std::size_t max_burst = 0)
+            : key_(std::move(key)), hash_(std::move(hash)),
+              max_burst_(max_burst ? max_burst : lane_cap)
+        {
+            lanes_.reserve(lanes ? lanes : 1);
+            for (std::size_t i = 0; i < (lanes ? lanes : 1); ++i)
+                lanes_.push_back(Lane{ std::make_unique<SpscRing<T>>(lane_cap) });
+            dirty_.reserve(lanes_.size());
+        }
+
+        KeyedDispatcher(const KeyedDispatcher&) = delete;
+        KeyedDispatcher& operator=(const KeyedDispatcher&) = delete;
+
+        std::size_t lanes() const noexcept { return lanes_.size(); }
+
+        // Consumer i polls lane(i); the producer must not pop from it
+        SpscRing<T>& lane(std::size_t i) noexcept { return *lanes_[i].ring; }
+
+        std::size_t lane_of(const Key& k) const noexcept
+        {
+            return reduce(mix(static_cast<std::uint64_t>(hash_(k))), lanes_.size());
+        }
+
+        bool push(const T& v) { return emplace_into(lane_of(key_(v)), v); }
+        bool push(T&& v) { std::size_t i = lane_of(key_(v)); return emplace_into(i, std::move(v)); }
+
+        // Key supplied up front so the message can be constructed in the slot
+        template <class... Args>
+        bool emplace(const Key& k, Args&&... args)
+        {
+            return emplace_into(lane_of(k), std::forward<Args>(args)...);
+        }
+
+        // Producer Thread: one release store per lane touched since the last flush
+        void flush() noexcept
+        {
+            for (std::size_t i : dirty_) {
+                if (lanes_[i].burst) publish_lane(i);
+                lanes_[i].dirty = false;
+            }
+            dirty_.clear();
+        }
+
+    private:
+        template <class... Args>
+        bool emplace_into(std::size_t i, Args&&... args)
+        {
+            Lane& lane = lanes_[i];
+            if (!lane.ring->try_stage(std::forward<Args>(args)...)) {
+                // Full: hand what is staged to the consumer, caller decides how to back off
+                if (lane.burst) publish_lane(i);
+                return false;
+            }
+            if (!lane.dirty) { lane.dirty = true; dirty_.push_back(i); }
+            ++lane.burst;
+            if (lane.burst >= max_burst_) publish_lane(i);
+            return true;
+        }
+
+        void publish_lane(std::size_t i) noexcept
+        {
+            lanes_[i].ring->publish();
+            lanes_[i].burst = 0;
+        }
+
+        // Fibonacci mixing: std::hash of integers is the identity on libstdc++
+        static constexpr std::uint64_t mix(std::uint64_t h) noexcept
+        {
+            h ^= h >> 32;
+            h *= 0x9E3779B97F4A7C15ull;
+            return h ^ (h >> 29);
+        }
+
+        // Power-of-two lane counts mask, everything else uses multiply-shift range reduction
+        static std::size_t reduce(std::uint64_t h, std::size_t n) noexcept
+        {
+            if (BitOps::isPow2(n)) return static_cast<std::size_t>(h & (n - 1));
+            return static_cast<std::size_t>(((h >> 32) * static_cast<std::uint64_t>(n)) >> 32);
+        }
+
+        KeyFn key_;
+        Hash hash_;
+        std::size_t max_burst_;
+        std::vector<Lane> lanes_;
+        std::vector<std::size_t> dirty_;
+    };
+
+} // namespace SPSC
@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace SPSC {
+
+    /**
+     * @Doorbell:  active set of non-empty mailboxes for one receiver (one bit per sender)
+     * - sender: publish the message, then ring(bit) (fetch_or, release)
+     * - receiver: take(word) (exchange 0, acquire), then poll the mailboxes whose bits were set
+     * - the RMW on both sides orders the sender's tail store before the receiver's poll;
+     *   a load-then-skip "already set" shortcut would reintroduce a store/load race
+     */
+    class Doorbell final
+    {
+    public:
+        explicit Doorbell(std::size_t bits) : words_((bits + 63) / 64), bits_(std::make_unique<std::atomic<std::uint64_t>[]>(words_)) {}
+
+        std::size_t words() const noexcept { return words_; }
+
+        void ring(std::size_t bit) noexcept
+        {
+            bits_[bit >> 6].fetch_or(1ull << (bit & 63), std::memory_order_release);
+        }
+
+        std::uint64_t take(std::size_t word) noexcept
+        {
+            // Skip the RMW on idle words
+            if (!bits_[word].load(std::memory_order_relaxed)) return 0;
+            return bits_[word].exchange(0, std::memory_order_acquire);
+        }
+
+    private:
+        std::size_t words_;
+        std::unique_ptr<std::atomic<std::uint64_t>[]> bits_;
+    };
+
+} // namespace SPSC
@@ -0,0 +1,146 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "spsc_ring.h"
+#include "spsc_wait.h"
+
+namespace SPSC {
+
+    template <class T>
+    struct Correlated final
+    {
+        std::uint64_t id;
+        T body;
+    };
+
+    /**
+     * @Duplex:        request/response channel over two SpscRings (client -> server, server -> client)
+     * @correlation:
+     * - ids come from a monotonic counter on the client; the server echoes them unchanged
+     * - responses land in a power-of-two completion table at id & (table - 1), no hashing
+     * - a call is refused while its table slot still holds an untaken (or unanswered) id,
+     *   so at most table-size requests are outstanding and ids never alias
+     * @threads:
+     * - client: try_call / call / poll / try_take
+     * - server: serve / requests() / responses() producer side
+     */
+    template <class Req, class Resp>
+    class Duplex final
+    {
+        enum class State : std::uint8_t { Free, Pending, Ready };
+
+        struct Completion final
+        {
+            alignas(Resp) std::byte obj_buf[sizeof(Resp)];
+            std::uint64_t id{ 0 };
+            State state{ State::Free };
+
+            Resp* raw() noexcept { return reinterpret_cast<Resp*>(obj_buf); }
+            Resp* obj() noexcept { return std::launder(reinterpret_cast<Resp*>(obj_buf)); }
+        };
+
+    public:
+        explicit Duplex(std::size_t cap)
+            : req_(cap), resp_(cap),
+              mask_(req_.capacity() - 1),
+              table_(std::make_unique<Completion[]>(req_.capacity())) {}
+
+        ~Duplex() noexcept
+        {
+            for (std::size_t i = 0; i <= mask_; ++i)
+                if (table_[i].state == State::Ready) std::destroy_at(table_[i].obj());
+        }
+
+        Duplex(const Duplex&) = delete;
+        Duplex& operator=(const Duplex&) = delete;
+
+        SpscRing<Correlated<Req>>& requests() noexcept { return req_; }
+        SpscRing<Correlated<Resp>>& responses() noexcept { return resp_; }
+
+        std::size_t max_outstanding() const noexcept { return mask_ + 1; }
+        std::uint64_t outstanding() const noexcept { return outstanding_; }
+
+        // Client Thread: send a request; id receives its correlation id
+        template <class... Args>
+        bool try_call(std::uint64_t& id, Args&&... args)
+        {
+            Completion& c = table_[next_id_ & mask_];
+            // Both checks before args are consumed, so a refused call can be retried as is
+            if (c.state != State::Free || req_.full()) return false;
+            req_.try_emplace(Correlated<Req>{ next_id_, Req(std::forward<Args>(args)...) });
+            c.id = next_id_;
+            c.state = State::Pending;
+            id = next_id_++;
+            ++outstanding_;
+            return true;
+        }
+
+        // Client Thread: move every arrived response into the completion table
+        std::size_t poll() noexcept
+        {
+            std::size_t n = 0;
+            for (Correlated<Resp>* r; (r = resp_.front()); ++n) {
+                Completion& c = table_[r->id & mask_];
+                std::construct_at(c.raw(), std::move(r->body));
+                c.state = State::Ready;
+                resp_.pop_front();
+            }
+            return n;
+        }
+
+        // Client Thread: claim the response for id if it has arrived (polls first)
+        bool try_take(std::uint64_t id, Resp& out)
+        {
+            Completion& c = table_[id & mask_];
+            if (c.id != id || c.state != State::Ready) {
+                poll();
+                if (c.id != id || c.state != State::Ready) return false;
+            }
+            Resp* r = c.obj();
+            out = std::move(*r);
+            std::destroy_at(r);
+            c.state = State::Free;
+            --outstanding_;
+            return true;
+        }
+
+        // Client Thread: synchronous round trip
+        template <class Wait = Wait::SpinPause, class... Args>
+        Resp call(Args&&... args)
+        {
+            Wait wait{};
+            std::uint64_t id = 0;
+            while (!try_call(id, std::forward<Args>(args)...)) { poll(); wait.wait(); }
+            Resp out{};
+            while (!try_take(id, out)) wait.wait();
+            return out;
+        }
+
+        // Server Thread: answer up to max requests with handler(Req&) -> Resp, in arrival order
+        template <class Handler>
+        std::size_t serve(Handler&& handler, std::size_t max = static_cast<std::size_t>(-1))
+        {
+            std::size_t n = 0;
+            for (Correlated<Req>* q; n < max && (q = req_.front()); ++n) {
+                // Client not polling: leave the request queued rather than run it twice
+                if (resp_.full()) break;
+                resp_.try_emplace(Correlated<Resp>{ q->id, handler(q->body) });
+                req_.pop_front();
+            }
+            return n;
+        }
+
+    private:
+        SpscRing<Correlated<Req>> req_;
+        SpscRing<Correlated<Resp>> resp_;
+        std::size_t mask_;
+        std::unique_ptr<Completion[]> table_;
+        std::uint64_t next_id_{ 0 };
+        std::uint64_t outstanding_{ 0 };
+    };
+
+} // namespace SPSC
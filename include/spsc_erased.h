@@ -0,0 +1,253 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    /**
+     * @ErasedRing:    SpscRing for records whose size is only known at run time (plugin schemas)
+     * - elem_size / elem_align fixed at construction; slots are stride = elem_size rounded up to
+     *   elem_align, indexed with the same power-of-two mask as SpscRing (usable = capacity() - 1)
+     * - elem_align 0 (the default) = the largest alignment a type of elem_size can have: its
+     *   lowest set bit, capped at alignof(max_align_t); 8-byte records get stride 8, not 16
+     * - records are raw bytes: push/pop copy them, nothing is constructed or destroyed
+     * @copy:
+     * - sizes 8/16/32/64 pick a size class at construction (whatever the alignment); push/pop
+     *   branch on it once and copy with a constant-size memcpy the compiler turns into a few moves
+     * - any other size goes through one memcpy(dst, src, elem_size)
+     * @batch:         push_n / pop_n move packed arrays of records with one index store; with
+     *                 stride == elem_size that is at most two memcpys per batch
+     * @zero_copy:     claim() / commit() write a record in place, front() / pop_front() read one
+     */
+    class ErasedRing final
+    {
+        enum class SizeClass : std::uint8_t { B8, B16, B32, B64, Generic };
+
+    public:
+        ErasedRing(std::size_t cap, std::size_t elem_size, std::size_t elem_align = 0)
+            : cap_(BitOps::roundCap(cap)), mask_(cap_ - 1), size_(elem_size), align_(elem_align ? elem_align : naturalAlign(elem_size))
+        {
+            if (!elem_size) throw std::invalid_argument("ErasedRing: elem_size must be > 0");
+            if (!BitOps::isPow2(align_)) throw std::invalid_argument("ErasedRing: elem_align must be a power of two");
+            if (!cap_) throw std::length_error("ErasedRing: capacity too large");
+            if (size_ > std::numeric_limits<std::size_t>::max() - (align_ - 1)) throw std::length_error("ErasedRing: elem_size too large");
+            stride_ = (size_ + align_ - 1) & ~(align_ - 1);
+            if (stride_ > std::numeric_limits<std::size_t>::max() / cap_) throw std::length_error("ErasedRing: capacity * stride overflows");
+            class_ = classify(size_);
+            buf_align_ = std::max<std::size_t>(align_, 64);
+            buf_ = static_cast<std::byte*>(::operator new(cap_ * stride_, std::align_val_t(buf_align_)));
+        }
+
+        ~ErasedRing() noexcept { ::operator delete(buf_, cap_ * stride_, std::align_val_t(buf_align_)); }
+
+        ErasedRing(const ErasedRing&) = delete;
+        ErasedRing& operator=(const ErasedRing&) = delete;
+
+        std::size_t capacity() const noexcept { return cap_; }
+        std::size_t elem_size() const noexcept { return size_; }
+        std::size_t elem_align() const noexcept { return align_; }
+        std::size_t stride() const noexcept { return stride_; }
+        bool fast_path() const noexcept { return class_ != SizeClass::Generic; }
+
+        std::size_t size() const noexcept
+        {
+            return (tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire)) & mask_;
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+
+        // ------------------------ Producer ------------------------
+
+        // Copy elem_size bytes from src
+        bool try_push(const void* src) noexcept
+        {
+            // Everything read from *this before the copy: the slot bytes may alias any object
+            const std::size_t tail = tail_local_;
+            const std::size_t next = (tail + 1) & mask_;
+            if (next == head_cache_) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (next == head_cache_) return false;
+            }
+            std::byte* dst = slot(tail);
+            const SizeClass c = class_;
+            const std::size_t n = size_;
+            tail_local_ = next;
+            copy(c, dst, src, n);
+            tail_.store(next, std::memory_order_release);
+            return true;
+        }
+
+        // Copy up to count records packed back to back (elem_size apart) from src; returns how many
+        std::size_t push_n(const void* src, std::size_t count) noexcept
+        {
+            const std::size_t tail = tail_local_;
+            std::size_t room = (head_cache_ - tail - 1) & mask_;
+            if (room < count) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                room = (head_cache_ - tail - 1) & mask_;
+            }
+            const std::size_t n = std::min(count, room);
+            if (!n) return 0;
+            const std::size_t next = (tail + n) & mask_;
+            tail_local_ = next;
+            copyIn(tail, n, static_cast<const std::byte*>(src));
+            tail_.store(next, std::memory_order_release);
+            return n;
+        }
+
+        // Free slot at the tail to fill in place (nullptr if full); invisible until commit()
+        void* claim() noexcept
+        {
+            const std::size_t next = (tail_local_ + 1) & mask_;
+            if (next == head_cache_) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (next == head_cache_) return nullptr;
+            }
+            return slot(tail_local_);
+        }
+
+        // Publish the claimed slot (pre-condition: claim() returned non-null)
+        void commit() noexcept
+        {
+            tail_local_ = (tail_local_ + 1) & mask_;
+            tail_.store(tail_local_, std::memory_order_release);
+        }
+
+        // ------------------------ Consumer ------------------------
+
+        // Copy the head record into dst (elem_size bytes)
+        bool try_pop(void* dst) noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) return false;
+            const std::byte* src = slot(head);
+            const SizeClass c = class_;
+            const std::size_t n = size_;
+            const std::size_t next = (head + 1) & mask_;
+            copy(c, dst, src, n);
+            head_.store(next, std::memory_order_release);
+            return true;
+        }
+
+        // Copy up to max records into dst, back to back (elem_size apart); one release store
+        std::size_t pop_n(void* dst, std::size_t max) noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            const std::size_t n = std::min(max, (tail_.load(std::memory_order_acquire) - head) & mask_);
+            if (!n) return 0;
+            copyOut(head, n, static_cast<std::byte*>(dst));
+            head_.store((head + n) & mask_, std::memory_order_release);
+            return n;
+        }
+
+        // Head record in place (nullptr if empty); valid until pop_front()
+        const void* front() noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) return nullptr;
+            return slot(head);
+        }
+
+        void pop_front() noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            head_.store((head + 1) & mask_, std::memory_order_release);
+        }
+
+    private:
+        static constexpr std::size_t naturalAlign(std::size_t size) noexcept
+        {
+            return size ? std::min(size & (~size + 1), alignof(std::max_align_t)) : 1;
+        }
+
+        // The copy moves elem_size bytes whatever the stride, so only the size matters
+        static SizeClass classify(std::size_t size) noexcept
+        {
+            switch (size) {
+                case 8:  return SizeClass::B8;
+                case 16: return SizeClass::B16;
+                case 32: return SizeClass::B32;
+                case 64: return SizeClass::B64;
+                default: return SizeClass::Generic;
+            }
+        }
+
+        std::byte* slot(std::size_t i) const noexcept { return buf_ + i * stride_; }
+
+        // n packed records from src into slots [first, first + n), wrapping; one size-class branch
+        // per record, or one memcpy per run when the ring is dense (stride == elem_size)
+        void copyIn(std::size_t first, std::size_t n, const std::byte* src) const noexcept
+        {
+            const SizeClass c = class_;
+            const std::size_t size = size_, stride = stride_;
+            std::byte* const base = buf_;
+            const std::size_t run1 = std::min(n, cap_ - first);
+            if (size == stride) {
+                std::memcpy(base + first * size, src, run1 * size);
+                std::memcpy(base, src + run1 * size, (n - run1) * size);
+                return;
+            }
+            for (std::size_t i = 0; i < n; ++i) copy(c, base + ((first + i) & mask_) * stride, src + i * size, size);
+        }
+
+        // Slots [first, first + n) into n packed records at dst
+        void copyOut(std::size_t first, std::size_t n, std::byte* dst) const noexcept
+        {
+            const SizeClass c = class_;
+            const std::size_t size = size_, stride = stride_;
+            const std::byte* const base = buf_;
+            const std::size_t run1 = std::min(n, cap_ - first);
+            if (size == stride) {
+                std::memcpy(dst, base + first * size, run1 * size);
+                std::memcpy(dst + run1 * size, base, (n - run1) * size);
+                return;
+            }
+            for (std::size_t i = 0; i < n; ++i) copy(c, dst + i * size, base + ((first + i) & mask_) * stride, size);
+        }
+
+        // GCC cannot tell which case is live and flags the wider copies against a caller's
+        // smaller buffer; the size class guarantees n == elem_size on every path
+        #if defined(__GNUC__) && !defined(__clang__)
+            #pragma GCC diagnostic push
+            #pragma GCC diagnostic ignored "-Warray-bounds"
+            #pragma GCC diagnostic ignored "-Wstringop-overread"
+            #pragma GCC diagnostic ignored "-Wstringop-overflow"
+        #endif
+        static void copy(SizeClass c, void* dst, const void* src, std::size_t n) noexcept
+        {
+            switch (c) {
+                case SizeClass::B8:  std::memcpy(dst, src, 8);  return;
+                case SizeClass::B16: std::memcpy(dst, src, 16); return;
+                case SizeClass::B32: std::memcpy(dst, src, 32); return;
+                case SizeClass::B64: std::memcpy(dst, src, 64); return;
+                case SizeClass::Generic: break;
+            }
+            std::memcpy(dst, src, n);
+        }
+        #if defined(__GNUC__) && !defined(__clang__)
+            #pragma GCC diagnostic pop
+        #endif
+
+        std::size_t cap_;
+        std::size_t mask_;
+        std::size_t size_;
+        std::size_t align_;
+        std::size_t stride_{ 0 };
+        std::size_t buf_align_{ 64 };
+        SizeClass class_{ SizeClass::Generic };
+        std::byte* buf_{ nullptr };
+        alignas(64) std::atomic<std::size_t> head_{ 0 };
+        alignas(64) std::atomic<std::size_t> tail_{ 0 };
+        alignas(64) std::size_t tail_local_{ 0 };       // producer-private
+        std::size_t head_cache_{ 0 };
+    };
+
+} // namespace SPSC
@@ -0,0 +1,259 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "spsc_pipeline.h"
+
+namespace SPSC {
+
+    enum class Cost { Cheap, Heavy };
+
+    /**
+     * @combinators:   map / filter / tap / batch(n) / unbatch / hop, chained with operator|
+     * @fusion:
+     * - consecutive operators run on one thread as nested calls (no ring, no copy between them)
+     * - a ring + thread boundary is inserted at hop(), and before a map<Cost::Heavy> that
+     *   is not already first in its segment (keeps cheap upstream work off the expensive thread)
+     * @build:        flow<In>() | ... | run<Wait>(opts) -> Pipeline of fused segments
+     * @bound_ops:
+     * - each operator is bound to its input type as it is appended (in_type / out_type)
+     * - push(v, k): hand 0..n results to continuation k; finish(k): flush at end of stream
+     */
+    namespace FlowOps {
+
+        template <class T, class F>
+        struct Map final
+        {
+            using in_type = T;
+            using out_type = std::decay_t<std::invoke_result_t<F&, T&&>>;
+            F f;
+
+            template <class K> bool push(T&& v, K&& k) { return k(std::invoke(f, std::move(v))); }
+            template <class K> bool finish(K&&) { return true; }
+        };
+
+        template <class T, class P>
+        struct Filter final
+        {
+            using in_type = T;
+            using out_type = T;
+            P pred;
+
+            template <class K> bool push(T&& v, K&& k) { return std::invoke(pred, std::as_const(v)) ? k(std::move(v)) : true; }
+            template <class K> bool finish(K&&) { return true; }
+        };
+
+        template <class T, class F>
+        struct Tap final
+        {
+            using in_type = T;
+            using out_type = T;
+            F f;
+
+            template <class K> bool push(T&& v, K&& k) { std::invoke(f, std::as_const(v)); return k(std::move(v)); }
+            template <class K> bool finish(K&&) { return true; }
+        };
+
+        template <class T>
+        struct Batch final
+        {
+            using in_type = T;
+            using out_type = std::vector<T>;
+            std::size_t n;
+            std::vector<T> buf{};
+
+            template <class K> bool push(T&& v, K&& k)
+            {
+                if (buf.capacity() < n) buf.reserve(n);
+                buf.push_back(std::move(v));
+                return buf.size() < n || emit(k);
+            }
+            // Partial batch goes out at end of stream only
+            template <class K> bool finish(K&& k) { return buf.empty() || emit(k); }
+
+        private:
+            template <class K> bool emit(K& k)
+            {
+                std::vector<T> full;
+                full.swap(buf);
+                return k(std::move(full));
+            }
+        };
+
+        template <class R>
+        struct Unbatch final
+        {
+            using in_type = R;
+            using out_type = std::ranges::range_value_t<R>;
+
+            template <class K> bool push(R&& v, K&& k)
+            {
+                for (auto& x : v) if (!k(std::move(x))) return false;
+                return true;
+            }
+            template <class K> bool finish(K&&) { return true; }
+        };
+
+        // ----------- Unbound operators, as written by the user -----------
+        template <class F, Cost C> struct MapSpec { F f; };
+        template <class P> struct FilterSpec { P pred; };
+        template <class F> struct TapSpec { F f; };
+        struct BatchSpec { std::size_t n; };
+        struct UnbatchSpec {};
+        struct HopSpec {};
+
+        template <class T, class F, Cost C> auto bind(MapSpec<F, C> s) { return Map<T, F>{ std::move(s.f) }; }
+        template <class T, class P> auto bind(FilterSpec<P> s) { return Filter<T, P>{ std::move(s.pred) }; }
+        template <class T, class F> auto bind(TapSpec<F> s) { return Tap<T, F>{ std::move(s.f) }; }
+        template <class T> auto bind(BatchSpec s) { return Batch<T>{ s.n ? s.n : 1 }; }
+        template <class T> auto bind(UnbatchSpec) { return Unbatch<T>{}; }
+
+        template <class S> inline constexpr bool starts_segment = false;
+        template <class F> inline constexpr bool starts_segment<MapSpec<F, Cost::Heavy>> = true;
+
+    } // namespace FlowOps
+
+    template <Cost C = Cost::Cheap, class F>
+    FlowOps::MapSpec<std::decay_t<F>, C> map(F&& f) { return { std::forward<F>(f) }; }
+
+    template <class P>
+    FlowOps::FilterSpec<std::decay_t<P>> filter(P&& pred) { return { std::forward<P>(pred) }; }
+
+    template <class F>
+    FlowOps::TapSpec<std::decay_t<F>> tap(F&& f) { return { std::forward<F>(f) }; }
+
+    inline FlowOps::BatchSpec batch(std::size_t n) { return { n }; }
+    inline FlowOps::UnbatchSpec unbatch() { return {}; }
+
+    // Explicit thread boundary
+    inline FlowOps::HopSpec hop() { return {}; }
+
+    /**
+     * @Segment:    fused run of bound operators; a PushStage for Pipeline
+     */
+    template <class In, class... Ops>
+    class Segment final : public PushStageBase
+    {
+    public:
+        using in_type = In;
+        using out_type = typename std::tuple_element_t<sizeof...(Ops), std::tuple<In, typename Ops::out_type...>>;
+
+        explicit Segment(std::tuple<Ops...> ops) : ops_(std::move(ops)) {}
+
+        static constexpr std::size_t size() noexcept { return sizeof...(Ops); }
+
+        template <class Op>
+        Segment<In, Ops..., Op> append(Op op) &&
+        {
+            return Segment<In, Ops..., Op>(std::tuple_cat(std::move(ops_), std::make_tuple(std::move(op))));
+        }
+
+        template <class Emit>
+        bool operator()(In&& v, Emit& emit) { return step<0>(std::move(v), emit); }
+
+        template <class Emit>
+        bool finish(Emit& emit) { return finish_from<0>(emit); }
+
+    private:
+        template <std::size_t I, class T, class Emit>
+        bool step(T&& v, Emit& emit)
+        {
+            if constexpr (I == sizeof...(Ops)) {
+                return emit(std::move(v));
+            } else {
+                return std::get<I>(ops_).push(std::move(v), [&](auto&& x) {
+                    return step<I + 1>(std::move(x), emit);
+                });
+            }
+        }
+
+        template <std::size_t I, class Emit>
+        bool finish_from(Emit& emit)
+        {
+            if constexpr (I == sizeof...(Ops)) {
+                return true;
+            } else {
+                bool ok = std::get<I>(ops_).finish([&](auto&& x) { return step<I + 1>(std::move(x), emit); });
+                return ok && finish_from<I + 1>(emit);
+            }
+        }
+
+        std::tuple<Ops...> ops_;
+    };
+
+    /**
+     * @Flow:       segments built so far; the last one is open for fusion
+     */
+    template <class In, class... Segs>
+    class Flow final
+    {
+        using Last = std::tuple_element_t<sizeof...(Segs) - 1, std::tuple<Segs...>>;
+
+    public:
+        using in_type = In;
+        using out_type = typename Last::out_type;
+
+        explicit Flow(std::tuple<Segs...> segs) : segs_(std::move(segs)) {}
+
+        static constexpr std::size_t segments() noexcept { return sizeof...(Segs); }
+
+        template <class Spec>
+        auto operator|(Spec spec) &&
+        {
+            if constexpr (std::is_same_v<Spec, FlowOps::HopSpec>) {
+                if constexpr (Last::size() == 0) return std::move(*this);     // already at a boundary
+                else return open_segment(Segment<out_type>({}));
+            } else if constexpr (FlowOps::starts_segment<Spec>) {
+                auto op = FlowOps::bind<out_type>(std::move(spec));
+                if constexpr (Last::size() == 0) return extend(std::move(op));
+                else return open_segment(Segment<out_type, decltype(op)>(std::make_tuple(std::move(op))));
+            } else {
+                return extend(FlowOps::bind<out_type>(std::move(spec)));
+            }
+        }
+
+        // One thread per segment, rings only between segments
+        template <class Wait = Wait::Backoff>
+        auto run(PipelineOptions opt) &&
+        {
+            return std::apply([&](auto&&... s) {
+                return makePipeline<In, Wait>(std::move(opt), std::move(s)...);
+            }, std::move(segs_));
+        }
+
+    private:
+        template <class Seg>
+        Flow<In, Segs..., Seg> open_segment(Seg seg)
+        {
+            return Flow<In, Segs..., Seg>(std::tuple_cat(std::move(segs_), std::make_tuple(std::move(seg))));
+        }
+
+        template <class Op>
+        auto extend(Op op)
+        {
+            return replace_last(std::move(std::get<sizeof...(Segs) - 1>(segs_)).append(std::move(op)),
+                                std::make_index_sequence<sizeof...(Segs) - 1>{});
+        }
+
+        template <class Seg, std::size_t... I>
+        auto replace_last(Seg seg, std::index_sequence<I...>)
+        {
+            using Next = Flow<In, std::tuple_element_t<I, std::tuple<Segs...>>..., Seg>;
+            return Next(std::tuple<std::tuple_element_t<I, std::tuple<Segs...>>..., Seg>(
+                std::move(std::get<I>(segs_))..., std::move(seg)));
+        }
+
+        std::tuple<Segs...> segs_;
+    };
+
+    template <class In>
+    Flow<In, Segment<In>> flow() { return Flow<In, Segment<In>>(std::tuple<Segment<In>>(Segment<In>({}))); }
+
+} // namespace SPSC
@@ -0,0 +1,318 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    /**
+     * @JournalRing:   SpscRing-style queue whose slots and indices live in a MAP_SHARED file
+     * @layout:        [header page: magic, geometry, tail, head][cap slots of {seq, T}]
+     * - positions are monotonic 64-bit counters (slot = pos & (cap - 1)), so all cap slots are
+     *   usable and a slot's seq (pos + 1) tells recovery whether it was fully written
+     * - slots are padded to a power of two of at most 4 KiB and start page aligned, so no slot
+     *   crosses a page: writeback cannot persist a slot's seq without the rest of its value
+     * @consumer:
+     * - pop_front() only advances a private read position; commit() publishes it as head_,
+     *   which is what the producer may overwrite behind and where a restarted consumer resumes
+     * - commit() runs every commit_every pops; checkpoint() is commit() + msync of the header,
+     *   also run from commit() once checkpoint_interval has passed
+     * - uncommitted pops are delivered again after a restart (at-least-once)
+     * @producer:      try_push(): memcpy + seq + one release store of tail_; flush() msyncs the
+     *                 slots written since the last flush, then the header
+     * @durability:
+     * - process crash: nothing is lost, the mapping is the page cache
+     * - OS crash / power loss: bounded by the last flush() (producer) and checkpoint() (consumer);
+     *   on open, slots whose seq does not match are cut from the tail (recovered())
+     * @create:        the first opener builds the file under a temporary name and links it into
+     *                 place once sized and initialized, so a concurrent opener either finds no
+     *                 file (and races to create one) or a complete journal, never an empty one
+     * @threads:       one producer and one consumer, in the same or different processes; open the
+     *                 file with no producer running, or from the producer side first
+     */
+    template <class T>
+        requires std::is_trivially_copyable_v<T>
+    class JournalRing final
+    {
+        static constexpr std::uint64_t kMagic = 0x4c4e524a43535053ull;   // "SPSCJRNL"
+        static constexpr std::uint32_t kVersion = 2;                     // 2: page-contained slots
+
+        struct alignas(64) Header final
+        {
+            std::atomic<std::uint64_t> magic;
+            std::uint32_t version;
+            std::uint32_t elem_size;
+            std::uint64_t capacity;
+            alignas(64) std::atomic<std::uint64_t> tail;     // next position the producer writes
+            alignas(64) std::atomic<std::uint64_t> head;     // committed consumer position
+        };
+
+        struct Packed final
+        {
+            std::uint64_t seq;
+            T value;
+        };
+
+        static constexpr std::size_t kSlotBytes = static_cast<std::size_t>(BitOps::ceilPow2(sizeof(Packed)));
+        static_assert(kSlotBytes <= 4096, "JournalRing: a slot must fit in one 4 KiB page");
+
+        struct alignas(kSlotBytes) Slot final
+        {
+            std::uint64_t seq;                               // pos + 1 once value is complete
+            T value;
+        };
+        static_assert(sizeof(Slot) == kSlotBytes);
+
+    public:
+        struct Options final
+        {
+            std::size_t commit_every{ 64 };                          // pops between automatic commits; 0 = explicit only
+            std::chrono::milliseconds checkpoint_interval{ 0 };      // commit() also msyncs once this has passed; 0 = never
+        };
+
+        JournalRing(const char* path, std::size_t cap, Options opt = {})
+            : cap_(BitOps::roundCap(cap)), opt_(opt)
+        {
+            static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "indices are shared across processes");
+            page_ = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            bytes_ = slotsOffset() + cap_ * sizeof(Slot);
+
+            // Only a sized, initialized journal ever appears under path (see create())
+            bool fresh = false;
+            int fd = ::open(path, O_RDWR | O_CLOEXEC);
+            if (fd < 0 && errno != ENOENT) throwErrno("JournalRing: open");
+            if (fd < 0) fd = create(path, fresh);
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) { ::close(fd); throwErrno("JournalRing: fstat"); }
+            if (static_cast<std::size_t>(st.st_size) != bytes_) {
+                ::close(fd);
+                throw std::invalid_argument("JournalRing: file geometry does not match");
+            }
+
+            void* p = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (p == MAP_FAILED) throwErrno("JournalRing: mmap");
+            base_ = static_cast<std::byte*>(p);
+            hdr_ = std::launder(reinterpret_cast<Header*>(base_));
+            slots_ = std::launder(reinterpret_cast<Slot*>(base_ + slotsOffset()));
+
+            if (!fresh) {
+                if (hdr_->magic.load(std::memory_order_acquire) != kMagic) { unmap(); throw std::invalid_argument("JournalRing: not a journal"); }
+                if (hdr_->version != kVersion || hdr_->elem_size != sizeof(T) || hdr_->capacity != cap_) {
+                    unmap();
+                    throw std::invalid_argument("JournalRing: file geometry does not match");
+                }
+                recover();
+            }
+
+            tail_ = hdr_->tail.load(std::memory_order_acquire);
+            flushed_ = tail_;
+            head_cache_ = hdr_->head.load(std::memory_order_acquire);
+            read_ = head_cache_;
+            committed_ = read_;
+            last_checkpoint_ = std::chrono::steady_clock::now();
+        }
+
+        ~JournalRing() { unmap(); }
+
+        JournalRing(const JournalRing&) = delete;
+        JournalRing& operator=(const JournalRing&) = delete;
+
+        std::size_t capacity() const noexcept { return cap_; }
+        static constexpr std::size_t slot_bytes() noexcept { return sizeof(Slot); }    // file stride of one slot
+        std::uint64_t recovered() const noexcept { return recovered_; }        // torn slots cut on open
+
+        // ------------------------ Producer ------------------------
+
+        bool try_push(const T& v) noexcept
+        {
+            if (tail_ - head_cache_ == cap_) {
+                head_cache_ = hdr_->head.load(std::memory_order_acquire);
+                if (tail_ - head_cache_ == cap_) return false;
+            }
+            Slot& s = slots_[tail_ & (cap_ - 1)];
+            std::memcpy(&s.value, std::addressof(v), sizeof(T));
+            s.seq = tail_ + 1;
+            hdr_->tail.store(++tail_, std::memory_order_release);
+            return true;
+        }
+
+        // Producer: write back slots pushed since the last flush, then the header with tail_
+        void flush() noexcept
+        {
+            const std::uint64_t n = tail_ - flushed_;
+            if (!n) return;
+            const std::size_t first = static_cast<std::size_t>(flushed_ & (cap_ - 1));
+            if (n >= cap_) {
+                syncRange(slotsOffset(), cap_ * sizeof(Slot));
+            } else if (first + n <= cap_) {
+                syncRange(slotsOffset() + first * sizeof(Slot), n * sizeof(Slot));
+            } else {
+                syncRange(slotsOffset() + first * sizeof(Slot), (cap_ - first) * sizeof(Slot));
+                syncRange(slotsOffset(), (first + n - cap_) * sizeof(Slot));
+            }
+            ::msync(base_, page_, MS_SYNC);
+            flushed_ = tail_;
+        }
+
+        // ------------------------ Consumer ------------------------
+
+        // Next unread element in place (nullptr if none); valid until pop_front()
+        const T* front() const noexcept
+        {
+            if (read_ == hdr_->tail.load(std::memory_order_acquire)) return nullptr;
+            return &slots_[read_ & (cap_ - 1)].value;
+        }
+
+        void pop_front() noexcept
+        {
+            ++read_;
+            if (opt_.commit_every && read_ - committed_ >= opt_.commit_every) commit();
+        }
+
+        bool try_pop(T& out) noexcept
+        {
+            const T* v = front();
+            if (!v) return false;
+            std::memcpy(std::addressof(out), v, sizeof(T));
+            pop_front();
+            return true;
+        }
+
+        // Publish the read position: its slots become reusable and a restart resumes here
+        void commit() noexcept
+        {
+            hdr_->head.store(read_, std::memory_order_release);
+            committed_ = read_;
+            if (opt_.checkpoint_interval.count() &&
+                std::chrono::steady_clock::now() - last_checkpoint_ >= opt_.checkpoint_interval) checkpoint();
+        }
+
+        // commit() and force the header (head_) to disk
+        void checkpoint() noexcept
+        {
+            hdr_->head.store(read_, std::memory_order_release);
+            committed_ = read_;
+            ::msync(base_, page_, MS_SYNC);
+            last_checkpoint_ = std::chrono::steady_clock::now();
+        }
+
+        std::uint64_t position() const noexcept { return read_; }
+        std::uint64_t committed() const noexcept { return committed_; }
+
+    private:
+        [[noreturn]] static void throwErrno(const char* what)
+        {
+            throw std::system_error(errno, std::system_category(), what);
+        }
+
+        // Build the journal under a temporary name, then link() it into place: openers never see
+        // an empty or half-initialized file, and a creator that dies midway leaves only the
+        // temporary behind. Losing the link race opens the winner's file instead (fresh = false)
+        int create(const char* path, bool& fresh)
+        {
+            std::string tmp = std::string(path) + ".XXXXXX";
+            const int fd = ::mkostemp(tmp.data(), O_CLOEXEC);
+            if (fd < 0) throwErrno("JournalRing: mkostemp");
+            auto fail = [&](const char* what) {
+                const int err = errno;
+                ::close(fd);
+                ::unlink(tmp.c_str());
+                throw std::system_error(err, std::system_category(), what);
+            };
+            if (::fchmod(fd, 0644) != 0) fail("JournalRing: fchmod");
+            if (::ftruncate(fd, static_cast<off_t>(bytes_)) != 0) fail("JournalRing: ftruncate");
+
+            void* p = ::mmap(nullptr, page_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) fail("JournalRing: mmap");
+            Header* h = std::launder(reinterpret_cast<Header*>(p));
+            h->version = kVersion;
+            h->elem_size = sizeof(T);
+            h->capacity = cap_;
+            h->tail.store(0, std::memory_order_relaxed);
+            h->head.store(0, std::memory_order_relaxed);
+            h->magic.store(kMagic, std::memory_order_release);
+            ::msync(p, page_, MS_SYNC);
+            ::munmap(p, page_);
+
+            if (::link(tmp.c_str(), path) == 0) {
+                ::unlink(tmp.c_str());
+                fresh = true;
+                return fd;
+            }
+            if (errno != EEXIST) fail("JournalRing: link");
+            ::close(fd);
+            ::unlink(tmp.c_str());
+            const int theirs = ::open(path, O_RDWR | O_CLOEXEC);
+            if (theirs < 0) throwErrno("JournalRing: open");
+            return theirs;
+        }
+
+        std::size_t slotsOffset() const noexcept
+        {
+            return (sizeof(Header) + page_ - 1) & ~(page_ - 1);
+        }
+
+        void syncRange(std::size_t offset, std::size_t len) noexcept
+        {
+            const std::size_t begin = offset & ~(page_ - 1);
+            ::msync(base_ + begin, offset + len - begin, MS_SYNC);
+        }
+
+        // Cut the tail back to the first slot whose contents never reached the file
+        void recover() noexcept
+        {
+            const std::uint64_t head = hdr_->head.load(std::memory_order_acquire);
+            const std::uint64_t tail = hdr_->tail.load(std::memory_order_acquire);
+            std::uint64_t pos = head;
+            while (pos != tail && pos - head < cap_ && slots_[pos & (cap_ - 1)].seq == pos + 1) ++pos;
+            if (pos != tail) {
+                recovered_ = tail - pos;
+                hdr_->tail.store(pos, std::memory_order_release);
+            }
+        }
+
+        void unmap() noexcept
+        {
+            if (base_) ::munmap(base_, bytes_);
+            base_ = nullptr;
+        }
+
+        std::size_t cap_;
+        Options opt_;
+        std::size_t page_{ 4096 };
+        std::size_t bytes_{ 0 };
+        std::byte* base_{ nullptr };
+        Header* hdr_{ nullptr };
+        Slot* slots_{ nullptr };
+        std::uint64_t recovered_{ 0 };
+
+        // producer-private
+        alignas(64) std::uint64_t tail_{ 0 };
+        std::uint64_t head_cache_{ 0 };
+        std::uint64_t flushed_{ 0 };
+
+        // consumer-private
+        alignas(64) std::uint64_t read_{ 0 };
+        std::uint64_t committed_{ 0 };
+        std::chrono::steady_clock::time_point last_checkpoint_{};
+    };
+
+} // namespace SPSC
@@ -0,0 +1,333 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+
+#include "spsc_ring.h"
+#include "spsc_trace.h"     // readTsc
+#include "spsc_wait.h"
+
+namespace SPSC {
+
+    enum class LogFullPolicy : std::uint8_t
+    {
+        Drop,       // count it and return
+        Block,      // spin until the backend frees a slot
+        Overwrite   // keep only the newest record in a per-thread side slot, sent once there is room
+    };
+
+    /**
+     * @LogRecord:     compact binary log entry, encoded on the hot thread, formatted on the backend
+     * - fmt: pointer to a string literal ("{}" placeholders), never copied
+     * - args: [tag][payload]...  ints/doubles 8 bytes, strings [u16 len][bytes] (truncated to fit)
+     */
+    template <std::size_t ArgBytes>
+    struct LogRecord final
+    {
+        enum Tag : std::uint8_t { Signed, Unsigned, Double, Bool, Str };
+
+        const char* fmt{ nullptr };
+        std::uint64_t ts{ 0 };
+        std::uint16_t used{ 0 };
+        std::byte args[ArgBytes];
+
+        LogRecord() = default;
+
+        template <class... Args>
+        LogRecord(const char* f, std::uint64_t t, const Args&... a) noexcept : fmt(f), ts(t)
+        {
+            (encode(a), ...);
+        }
+
+        // Backend: render fmt with the decoded arguments
+        void format(std::string& out) const
+        {
+            std::size_t pos = 0;
+            for (const char* p = fmt; *p; ++p) {
+                if (p[0] == '{' && p[1] == '}') {
+                    pos = decode(out, pos);
+                    ++p;
+                } else {
+                    out.push_back(*p);
+                }
+            }
+        }
+
+    private:
+        template <class T>
+        void put(Tag tag, const T& v) noexcept
+        {
+            if (used + 1 + sizeof(T) > ArgBytes) return;
+            args[used++] = static_cast<std::byte>(tag);
+            std::memcpy(args + used, &v, sizeof(T));
+            used += sizeof(T);
+        }
+
+        void putStr(std::string_view s) noexcept
+        {
+            if (std::size_t{ used } + 3 > ArgBytes) return;
+            auto len = static_cast<std::uint16_t>(std::min<std::size_t>(s.size(), ArgBytes - used - 3));
+            args[used++] = static_cast<std::byte>(Str);
+            std::memcpy(args + used, &len, 2);
+            std::memcpy(args + used + 2, s.data(), len);
+            used += 2 + len;
+        }
+
+        template <class T>
+        void encode(const T& v) noexcept
+        {
+            if constexpr (std::is_same_v<T, bool>) put(Bool, static_cast<std::uint8_t>(v));
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) put(Signed, static_cast<std::int64_t>(v));
+            else if constexpr (std::is_integral_v<T>) put(Unsigned, static_cast<std::uint64_t>(v));
+            else if constexpr (std::is_floating_point_v<T>) put(Double, static_cast<double>(v));
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>) putStr(std::string_view(v));
+            else static_assert(sizeof(T) == 0, "unsupported log argument type");
+        }
+
+        std::size_t decode(std::string& out, std::size_t pos) const
+        {
+            if (pos >= used) { out += "{}"; return pos; }
+            const auto tag = static_cast<Tag>(args[pos++]);
+            char buf[32];
+            switch (tag) {
+                case Signed:   { std::int64_t v;  std::memcpy(&v, args + pos, 8); out.append(buf, std::to_chars(buf, buf + 32, v).ptr); return pos + 8; }
+                case Unsigned: { std::uint64_t v; std::memcpy(&v, args + pos, 8); out.append(buf, std::to_chars(buf, buf + 32, v).ptr); return pos + 8; }
+                case Double:   { double v;        std::memcpy(&v, args + pos, 8); out.append(buf, std::to_chars(buf, buf + 32, v).ptr); return pos + 8; }
+                case Bool:     { out += args[pos] != std::byte{ 0 } ? "true" : "false"; return pos + 1; }
+                case Str:      {
+                    std::uint16_t len;
+                    std::memcpy(&len, args + pos, 2);
+                    out.append(reinterpret_cast<const char*>(args + pos + 2), len);
+                    return pos + 2 + len;
+                }
+            }
+            return used;
+        }
+    };
+
+    /**
+     * @BasicAsyncLogger:  per-thread SpscRing of LogRecords drained by one formatting thread
+     * @hot_path:          readTsc + argument memcpy straight into the slot + one release store
+     * @registration:      a thread's ring is created on its first log() and appended to a
+     *                     fixed table (one fetch_add per thread and logger, never on the hot path);
+     *                     the thread finds it again by this logger's instance id, not its address
+     * @backend:           formats into one buffer and write()s it once it passes flush_bytes,
+     *                     or whenever a pass finds nothing new
+     * @write_errors:
+     * - EINTR is retried; EAGAIN keeps the unwritten tail for the next pass, up to
+     *   4 x flush_bytes (a non-blocking fd whose reader fell behind)
+     * - any other error, a tail past that bound, or anything still pending at shutdown is
+     *   discarded and counted in unwritten_bytes()
+     * @lifetime:
+     * - rings outlive their threads; the destructor drains everything left, then writes each
+     *   thread's parked Overwrite record (the newest it logged)
+     * - every log() must happen-before the destructor (join the hot threads first)
+     * - a parked record is otherwise sent by its thread's next log(); an idle thread's last
+     *   record waits until then or until shutdown
+     */
+    template <std::size_t ArgBytes = 112, class Wait = Wait::Backoff>
+    class BasicAsyncLogger final
+    {
+        using Record = LogRecord<ArgBytes>;
+
+        struct alignas(64) Producer final
+        {
+            explicit Producer(std::size_t cap) : ring(cap) {}
+
+            SpscRing<Record> ring;
+            alignas(64) Record side{};          // Overwrite policy: newest record that did not fit
+            bool side_full{ false };
+            std::atomic<std::uint64_t> dropped{ 0 };
+            std::atomic<std::uint64_t> overwritten{ 0 };
+        };
+
+        using Roles = Detail::ThreadRoles<BasicAsyncLogger, Producer*>;
+
+    public:
+        struct Options final
+        {
+            std::size_t ring_cap{ 4096 };
+            std::size_t max_threads{ 64 };
+            std::size_t flush_bytes{ 64 * 1024 };
+            LogFullPolicy policy{ LogFullPolicy::Drop };
+        };
+
+        explicit BasicAsyncLogger(int fd, Options opt = {})
+            : fd_(fd), opt_(opt),
+              producers_(std::make_unique<std::atomic<Producer*>[]>(opt_.max_threads)),
+              owned_(std::make_unique<std::unique_ptr<Producer>[]>(opt_.max_threads))
+        {
+            out_.reserve(opt_.flush_bytes * 2);
+            backend_ = std::jthread([this](std::stop_token st) { run(st); });
+        }
+
+        ~BasicAsyncLogger()
+        {
+            backend_.request_stop();
+            backend_.join();
+        }
+
+        BasicAsyncLogger(const BasicAsyncLogger&) = delete;
+        BasicAsyncLogger& operator=(const BasicAsyncLogger&) = delete;
+
+        // Hot Thread: false if the record was dropped (or, under Overwrite, parked/replaced)
+        template <class... Args>
+        bool log(const char* fmt, const Args&... args)
+        {
+            Producer& p = producer();
+            const std::uint64_t ts = readTsc();
+
+            if (p.side_full) {
+                if (!p.ring.try_emplace(p.side)) return park(p, fmt, ts, args...);
+                p.side_full = false;
+            }
+            if (p.ring.try_emplace(fmt, ts, args...)) return true;
+
+            switch (opt_.policy) {
+                case LogFullPolicy::Drop:
+                    p.dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                case LogFullPolicy::Block: {
+                    Wait wait{};
+                    while (!p.ring.try_emplace(fmt, ts, args...)) wait.wait();
+                    return true;
+                }
+                case LogFullPolicy::Overwrite:
+                    return park(p, fmt, ts, args...);
+            }
+            return false;
+        }
+
+        std::uint64_t dropped() const noexcept { return sum(&Producer::dropped); }
+        std::uint64_t overwritten() const noexcept { return sum(&Producer::overwritten); }
+        std::uint64_t unwritten_bytes() const noexcept { return unwritten_.load(std::memory_order_relaxed); }
+
+    private:
+        template <class... Args>
+        bool park(Producer& p, const char* fmt, std::uint64_t ts, const Args&... args) noexcept
+        {
+            if (p.side_full) p.overwritten.fetch_add(1, std::memory_order_relaxed);
+            p.side = Record(fmt, ts, args...);
+            p.side_full = true;
+            return false;
+        }
+
+        Producer& producer()
+        {
+            if (Producer** p = Roles::find(id_)) return **p;
+
+            // Claim a slot; only the claimant writes it, the backend skips it until published
+            const std::size_t idx = claimed_.fetch_add(1, std::memory_order_relaxed);
+            if (idx >= opt_.max_threads) throw std::runtime_error("BasicAsyncLogger: too many threads");
+            owned_[idx] = std::make_unique<Producer>(opt_.ring_cap);
+            producers_[idx].store(owned_[idx].get(), std::memory_order_release);
+            return *Roles::add(id_, owned_[idx].get());
+        }
+
+        std::uint64_t sum(std::atomic<std::uint64_t> Producer::* field) const noexcept
+        {
+            std::uint64_t total = 0;
+            const std::size_t n = claimed_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < n && i < opt_.max_threads; ++i)
+                if (Producer* p = producers_[i].load(std::memory_order_acquire)) total += (p->*field).load(std::memory_order_relaxed);
+            return total;
+        }
+
+        // Backend: one pass over every registered ring
+        std::size_t drain()
+        {
+            std::size_t n = 0;
+            const std::size_t threads = claimed_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < threads && i < opt_.max_threads; ++i) {
+                Producer* p = producers_[i].load(std::memory_order_acquire);
+                if (!p) continue;   // claimed, not yet published
+                for (Record* r; (r = p->ring.front()); ++n) {
+                    emit(*r);
+                    p->ring.pop_front();
+                }
+            }
+            return n;
+        }
+
+        // Backend, shutdown only: the hot threads are done, so their side slots can be read
+        void drain_parked()
+        {
+            const std::size_t threads = claimed_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < threads && i < opt_.max_threads; ++i) {
+                Producer* p = producers_[i].load(std::memory_order_acquire);
+                if (!p || !p->side_full) continue;
+                emit(p->side);
+                p->side_full = false;
+            }
+        }
+
+        void emit(const Record& r)
+        {
+            out_ += '[';
+            char buf[24];
+            out_.append(buf, std::to_chars(buf, buf + sizeof(buf), r.ts).ptr);
+            out_ += "] ";
+            r.format(out_);
+            out_ += '\n';
+            if (out_.size() >= opt_.flush_bytes) write_out();
+        }
+
+        // Backend: keep_tail is false at shutdown, when there is no next pass to retry from
+        void write_out(bool keep_tail = true) noexcept
+        {
+            std::size_t done = 0;
+            while (done < out_.size()) {
+                const ssize_t w = ::write(fd_, out_.data() + done, out_.size() - done);
+                if (w > 0) { done += static_cast<std::size_t>(w); continue; }
+                if (w < 0 && errno == EINTR) continue;
+
+                const std::size_t left = out_.size() - done;
+                if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && keep_tail && left <= opt_.flush_bytes * 4) {
+                    out_.erase(0, done);
+                    return;
+                }
+                unwritten_.fetch_add(left, std::memory_order_relaxed);
+                break;
+            }
+            out_.clear();
+        }
+
+        void run(std::stop_token st)
+        {
+            Wait wait{};
+            while (!st.stop_requested()) {
+                if (drain()) { wait.reset(); continue; }
+                if (!out_.empty()) write_out();
+                wait.wait();
+            }
+            drain();
+            drain_parked();     // newer than anything its thread left in the ring
+            write_out(false);
+        }
+
+        const std::uint64_t id_{ Detail::nextInstanceId() };
+        int fd_;
+        Options opt_;
+        std::unique_ptr<std::atomic<Producer*>[]> producers_;
+        std::unique_ptr<std::unique_ptr<Producer>[]> owned_;
+        std::atomic<std::size_t> claimed_{ 0 };
+        std::string out_;
+        std::atomic<std::uint64_t> unwritten_{ 0 };
+        std::jthread backend_;
+    };
+
+    using AsyncLogger = BasicAsyncLogger<>;
+
+} // namespace SPSC
@@ -0,0 +1,150 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    /**
+     * @TimestampMerge:    K-way merge consumer over K feed rings in global timestamp order
+     * @heads:
+     * - ring heads are peeked in place (front()), never popped until emitted
+     * - min-heap of { head timestamp, ring } for rings that currently have a head
+     * - rings without a head sit on the idle list and are re-peeked on every poll
+     * @lateness:
+     * - with every ring live, the heap top is always safe to emit
+     * - with some ring idle, the top is held until now >= ts + lateness, so a silent feed
+     *   delays the others by at most the bound; anything it later sends older than the
+     *   last emitted timestamp is still delivered, and counted in late()
+     * @allocation:       heap and idle list are reserved for K at construction; poll() never allocates
+     * @threads:          ring(i).try_push: feed i; poll: the merge thread
+     */
+    template <class T, class TsFn>
+    class TimestampMerge final
+    {
+        struct Head final
+        {
+            std::uint64_t ts;
+            std::uint32_t ring;
+        };
+
+        // std heap algorithms build a max-heap; invert for the earliest timestamp on top
+        struct Later final
+        {
+            bool operator()(const Head& a, const Head& b) const noexcept
+            {
+                return a.ts != b.ts ? a.ts > b.ts : a.ring > b.ring;
+            }
+        };
+
+    public:
+        explicit TimestampMerge(std::size_t rings, std::size_t ring_cap, std::uint64_t lateness, TsFn ts = TsFn{})
+            : ts_(std::move(ts)), lateness_(lateness)
+        {
+            const std::size_t k = rings ? rings : 1;
+            rings_.reserve(k);
+            heap_.reserve(k);
+            idle_.reserve(k);
+            for (std::size_t i = 0; i < k; ++i) {
+                rings_.push_back(std::make_unique<SpscRing<T>>(ring_cap));
+                idle_.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+
+        TimestampMerge(const TimestampMerge&) = delete;
+        TimestampMerge& operator=(const TimestampMerge&) = delete;
+
+        std::size_t rings() const noexcept { return rings_.size(); }
+        SpscRing<T>& ring(std::size_t i) noexcept { return *rings_[i]; }
+
+        std::uint64_t lateness() const noexcept { return lateness_; }
+        void set_lateness(std::uint64_t l) noexcept { lateness_ = l; }
+
+        // Emitted with a timestamp older than one already emitted (a feed beat the bound)
+        std::uint64_t late() const noexcept { return late_; }
+
+        /**
+         * @poll:  Merge Thread; emit(T&) in timestamp order, element popped after emit returns
+         * - now: same clock domain as TsFn; returns the number emitted (at most max)
+         */
+        template <class Emit>
+        std::size_t poll(std::uint64_t now, Emit&& emit, std::size_t max = static_cast<std::size_t>(-1))
+        {
+            refill();
+
+            std::size_t emitted = 0;
+            while (emitted < max && !heap_.empty()) {
+                const Head top = heap_.front();
+                if (!idle_.empty() && withinBound(now, top.ts)) {
+                    // An idle feed may still produce something earlier; look once more
+                    refill();
+                    if (!idle_.empty() && withinBound(now, heap_.front().ts)) break;
+                    continue;
+                }
+
+                std::pop_heap(heap_.begin(), heap_.end(), Later{});
+                heap_.pop_back();
+
+                SpscRing<T>& r = *rings_[top.ring];
+                if (top.ts < last_ts_) ++late_;
+                else last_ts_ = top.ts;
+
+                emit(*r.front());
+                r.pop_front();
+                ++emitted;
+
+                track(top.ring);
+            }
+            return emitted;
+        }
+
+    private:
+        // now < ts + lateness_ without the overflow (lateness may be UINT64_MAX = wait forever);
+        // a head stamped after now is always within the bound
+        bool withinBound(std::uint64_t now, std::uint64_t ts) const noexcept
+        {
+            return now < ts || now - ts < lateness_;
+        }
+
+        // Peek ring i and place it on the heap or the idle list
+        void track(std::uint32_t i)
+        {
+            if (!enter(i)) idle_.push_back(i);
+        }
+
+        bool enter(std::uint32_t i)
+        {
+            T* head = rings_[i]->front();
+            if (!head) return false;
+            heap_.push_back(Head{ static_cast<std::uint64_t>(ts_(*head)), i });
+            std::push_heap(heap_.begin(), heap_.end(), Later{});
+            return true;
+        }
+
+        void refill()
+        {
+            for (std::size_t k = 0; k < idle_.size();) {
+                if (enter(idle_[k])) {
+                    idle_[k] = idle_.back();
+                    idle_.pop_back();
+                } else {
+                    ++k;
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<SpscRing<T>>> rings_;
+        std::vector<Head> heap_;
+        std::vector<std::uint32_t> idle_;
+        TsFn ts_;
+        std::uint64_t lateness_;
+        std::uint64_t last_ts_{ 0 };
+        std::uint64_t late_{ 0 };
+    };
+
+} // namespace SPSC
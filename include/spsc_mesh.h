@@ -0,0 +1,224 @@
+#pragma once
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    /**
+     * @MeshArena:     one anonymous mapping backing every ring of a mesh
+     * - one contiguous region means fewer distinct pages for the TLB; THP is requested
+     * - region r can be bound to a NUMA node with bind(); best effort, silently skipped
+     *   where mbind is unavailable or refused
+     * - zero bytes maps nothing; data() is then null
+     */
+    class MeshArena final
+    {
+    public:
+        static constexpr std::size_t kHugePage = std::size_t{ 2 } << 20;
+
+        explicit MeshArena(std::size_t bytes)
+            : bytes_((bytes + kHugePage - 1) & ~(kHugePage - 1))
+        {
+            if (!bytes_) return;
+            #if defined(__linux__)
+                void* p = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED) throw std::bad_alloc();
+                #ifdef MADV_HUGEPAGE
+                    ::madvise(p, bytes_, MADV_HUGEPAGE);
+                #endif
+                base_ = static_cast<std::byte*>(p);
+            #else
+                base_ = static_cast<std::byte*>(::operator new(bytes_, std::align_val_t{ kHugePage }));
+            #endif
+        }
+
+        ~MeshArena()
+        {
+            if (!base_) return;
+            #if defined(__linux__)
+                ::munmap(base_, bytes_);
+            #else
+                ::operator delete(base_, std::align_val_t{ kHugePage });
+            #endif
+        }
+
+        MeshArena(const MeshArena&) = delete;
+        MeshArena& operator=(const MeshArena&) = delete;
+
+        std::byte* data() noexcept { return base_; }
+        std::size_t size() const noexcept { return bytes_; }
+
+        // Prefer node for [offset, offset + len); must be called before the pages are touched
+        bool bind(std::size_t offset, std::size_t len, int node) noexcept
+        {
+            #if defined(__linux__) && defined(SYS_mbind)
+                if (node < 0 || node >= 64) return false;
+                constexpr int kMpolPreferred = 1;   // <linux/mempolicy.h> MPOL_PREFERRED
+                unsigned long mask = 1ul << node;
+                return ::syscall(SYS_mbind, base_ + offset, len, kMpolPreferred, &mask, 64ul, 0u) == 0;
+            #else
+                (void)offset; (void)len; (void)node;
+                return false;
+            #endif
+        }
+
+    private:
+        std::size_t bytes_;
+        std::byte* base_{ nullptr };
+    };
+
+    /**
+     * @ShardMesh:     all-to-all channels for N thread-per-core shards, N x (N-1) SpscRings
+     * @placement:
+     * - every ring delivering to shard r lives in r's block of a shared MeshArena
+     * - blocks are huge-page aligned, so with node_of_shard given each is mbind'ed to the
+     *   receiver's node (consumer-local slot reads; the producer pays the remote write)
+     * @ports:
+     * - port(i) is shard i's view: send(to, v) / flush() / flush(to) / poll(f)
+     * - send() stages only; flush() publishes each destination dirtied since the last flush
+     * - a destination is published early when its ring fills
+     * - there is no ring from a shard to itself: send(id(), ...) and send(to >= shards()) throw
+     *   std::invalid_argument (a shard hands work to itself directly), flush(id()) is a no-op
+     * @shards:
+     * - zero throws std::invalid_argument; one is a mesh with no rings (poll() returns 0,
+     *   every send() throws)
+     * @threads:          port(i) is used by shard i's thread only
+     */
+    template <class T>
+    class ShardMesh final
+    {
+        using Ring = SpscRing<T>;
+
+    public:
+        class Port final
+        {
+        public:
+            std::size_t id() const noexcept { return me_; }
+
+            template <class... Args>
+            bool send(std::size_t to, Args&&... args)
+            {
+                if (to == me_ || to >= mesh_->shards()) throw std::invalid_argument("ShardMesh: send to self or past the last shard");
+                Ring& r = mesh_->ring(me_, to);
+                if (!r.try_stage(std::forward<Args>(args)...)) {
+                    r.publish();
+                    return false;
+                }
+                dirty_[to >> 6] |= 1ull << (to & 63);
+                return true;
+            }
+
+            void flush(std::size_t to) noexcept
+            {
+                if (to == me_ || to >= mesh_->shards()) return;
+                mesh_->ring(me_, to).publish();
+                dirty_[to >> 6] &= ~(1ull << (to & 63));
+            }
+
+            void flush() noexcept
+            {
+                for (std::size_t w = 0; w < dirty_.size(); ++w) {
+                    for (std::uint64_t bits = dirty_[w]; bits; bits &= bits - 1)
+                        mesh_->ring(me_, w * 64 + static_cast<std::size_t>(std::countr_zero(bits))).publish();
+                    dirty_[w] = 0;
+                }
+            }
+
+            // f(from, T&) on up to budget messages per sender; element destroyed after f returns
+            template <class F>
+            std::size_t poll(F&& f, std::size_t budget = 64)
+            {
+                std::size_t n = 0;
+                const std::size_t shards = mesh_->shards();
+                for (std::size_t k = 1; k < shards; ++k) {
+                    std::size_t from = me_ + k < shards ? me_ + k : me_ + k - shards;
+                    Ring& r = mesh_->ring(from, me_);
+                    std::size_t taken = 0;
+                    for (T* v; taken < budget && (v = r.front()); ++taken) {
+                        f(from, *v);
+                        r.pop_front();
+                    }
+                    n += taken;
+                }
+                return n;
+            }
+
+        private:
+            friend class ShardMesh;
+            Port(ShardMesh* mesh, std::size_t me) : mesh_(mesh), me_(me), dirty_((mesh->shards() + 63) / 64, 0) {}
+
+            ShardMesh* mesh_;
+            std::size_t me_;
+            std::vector<std::uint64_t> dirty_;
+        };
+
+        explicit ShardMesh(std::size_t shards, std::size_t ring_cap, const std::vector<int>& node_of_shard = {})
+            : shards_(checkShards(shards)),
+              block_(blockBytes(shards_, ring_cap)),
+              arena_(block_ * shards_)
+        {
+            const std::size_t ring_bytes = Ring::storage_bytes(ring_cap);
+            rings_.resize(shards_ * shards_);
+            for (std::size_t to = 0; to < shards_; ++to) {
+                if (to < node_of_shard.size()) arena_.bind(to * block_, block_, node_of_shard[to]);
+                std::size_t off = to * block_;
+                for (std::size_t from = 0; from < shards_; ++from) {
+                    if (from == to) continue;
+                    rings_[from * shards_ + to] = std::make_unique<Ring>(ring_cap, arena_.data() + off);
+                    off += alignUp(ring_bytes, Ring::storage_align);
+                }
+            }
+            ports_.reserve(shards_);
+            for (std::size_t i = 0; i < shards_; ++i) ports_.push_back(Port(this, i));
+        }
+
+        ShardMesh(const ShardMesh&) = delete;
+        ShardMesh& operator=(const ShardMesh&) = delete;
+
+        std::size_t shards() const noexcept { return shards_; }
+        Port& port(std::size_t i) noexcept { return ports_[i]; }
+        // Pre-condition: from != to (the diagonal has no ring)
+        Ring& ring(std::size_t from, std::size_t to) noexcept
+        {
+            assert(from != to && from < shards_ && to < shards_);
+            return *rings_[from * shards_ + to];
+        }
+
+    private:
+        static constexpr std::size_t alignUp(std::size_t v, std::size_t a) noexcept { return (v + a - 1) & ~(a - 1); }
+
+        static std::size_t checkShards(std::size_t shards)
+        {
+            if (!shards) throw std::invalid_argument("ShardMesh: zero shards");
+            return shards;
+        }
+
+        static std::size_t blockBytes(std::size_t shards, std::size_t ring_cap) noexcept
+        {
+            std::size_t per_ring = alignUp(Ring::storage_bytes(ring_cap), Ring::storage_align);
+            return alignUp(per_ring * (shards - 1), MeshArena::kHugePage);
+        }
+
+        std::size_t shards_;
+        std::size_t block_;
+        MeshArena arena_;
+        std::vector<std::unique_ptr<Ring>> rings_;     // [from * shards + to], diagonal empty
+        std::vector<Port> ports_;
+    };
+
+} // namespace SPSC
@@ -0,0 +1,249 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    // Visitor from lambdas: msgs.poll(Overloaded{ [](Quote&) {...}, [](Trade&) {...} })
+    template <class... Fs>
+    struct Overloaded : Fs... { using Fs::operator()...; };
+
+    template <class... Fs>
+    Overloaded(Fs...) -> Overloaded<Fs...>;
+
+    /**
+     * @MessageRing:   one channel, several message types, each record only as large as its own type
+     * @layout:        byte ring of records [Header{tag, units}][pad to alignof(M)][M]
+     * - a record is a whole number of units (unit = max(4, alignof(Ts)...)); a 4-byte header is
+     *   the whole per-message overhead, unlike std::variant slots that all take the largest type
+     * - a record that would straddle the end is preceded by a pad record and starts at 0, so every
+     *   message is contiguous and read in place
+     * - positions are monotonic byte counters; all capacity bytes are usable
+     * @dispatch:
+     * - poll(f) / try_dispatch(f): f(M&) is called in place, then M is destroyed
+     * - the tag selects the handler through a fold over the type list, which the compiler turns
+     *   into a switch (a jump table for many types) with every handler inlined; an array of
+     *   function pointers measured ~10% slower than std::visit because nothing inlines
+     * - poll() releases everything it handled with one store of head_
+     * @threads:       one producer (try_emplace/try_stage/publish), one consumer (poll/try_dispatch)
+     */
+    template <class... Ts>
+    class MessageRing final
+    {
+        static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) < 0xFFFF, "1..65534 message types");
+
+        struct Header final
+        {
+            std::uint16_t tag;
+            std::uint16_t units;        // record length in units, header included
+        };
+
+        static constexpr std::uint16_t kPad = 0xFFFF;
+        static constexpr std::size_t kUnit = std::max({ sizeof(Header), alignof(Ts)... });
+
+        template <class M>
+        static constexpr std::size_t payloadOffset = (sizeof(Header) + alignof(M) - 1) & ~(alignof(M) - 1);
+
+        template <class M>
+        static constexpr std::size_t recordBytes = (payloadOffset<M> + sizeof(M) + kUnit - 1) & ~(kUnit - 1);
+
+        static constexpr std::size_t kMaxRecord = std::max({ recordBytes<Ts>... });
+        static_assert(kMaxRecord / kUnit <= std::numeric_limits<std::uint16_t>::max(), "message type too large");
+
+        template <class M>
+        static constexpr std::uint16_t tagOf() noexcept
+        {
+            constexpr bool match[] = { std::is_same_v<M, Ts>... };
+            for (std::uint16_t i = 0; i < sizeof...(Ts); ++i) if (match[i]) return i;
+            return kPad;
+        }
+
+        template <class M>
+        static constexpr bool is_message = (std::is_same_v<M, Ts> || ...);
+
+    public:
+        // bytes: rounded up to a power of two, at least two of the largest record
+        explicit MessageRing(std::size_t bytes)
+            : cap_(BitOps::roundCap(std::max(bytes, 2 * kMaxRecord))), mask_(cap_ - 1),
+              buf_(static_cast<std::byte*>(::operator new(cap_, std::align_val_t(kUnit))))
+        {
+        }
+
+        ~MessageRing() noexcept
+        {
+            std::size_t pos = head_.load(std::memory_order_relaxed);
+            while (pos != tail_pending_) {
+                const Header h = header(pos);
+                if (h.tag != kPad) kDestroy[h.tag](buf_ + (pos & mask_));
+                pos += std::size_t{ h.units } * kUnit;
+            }
+            ::operator delete(buf_, cap_, std::align_val_t(kUnit));
+        }
+
+        MessageRing(const MessageRing&) = delete;
+        MessageRing& operator=(const MessageRing&) = delete;
+
+        std::size_t capacity() const noexcept { return cap_; }                         // bytes
+        template <class M> static constexpr std::size_t footprint() noexcept { return recordBytes<M>; }
+
+        // ------------------------ Producer ------------------------
+
+        template <class M, class... Args>
+            requires is_message<M> && std::constructible_from<M, Args...>
+        bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<M, Args...>)
+        {
+            if (!try_stage<M>(std::forward<Args>(args)...)) return false;
+            publish();
+            return true;
+        }
+
+        template <class M>
+            requires is_message<std::remove_cvref_t<M>>
+        bool try_push(M&& m) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<M>, M>)
+        {
+            return try_emplace<std::remove_cvref_t<M>>(std::forward<M>(m));
+        }
+
+        // Construct in place at the pending tail; invisible to the consumer until publish()
+        template <class M, class... Args>
+            requires is_message<M> && std::constructible_from<M, Args...>
+        bool try_stage(Args&&... args) noexcept(std::is_nothrow_constructible_v<M, Args...>)
+        {
+            constexpr std::size_t need = recordBytes<M>;
+            std::size_t pos = tail_pending_;
+            const std::size_t room = cap_ - (pos & mask_);
+            const std::size_t pad = need <= room ? 0 : room;
+
+            if (pos + pad + need - head_cache_ > cap_) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (pos + pad + need - head_cache_ > cap_) return false;
+            }
+
+            if (pad) {
+                writeHeader(pos, Header{ kPad, static_cast<std::uint16_t>(pad / kUnit) });
+                pos += pad;
+            }
+            std::byte* rec = buf_ + (pos & mask_);
+            std::construct_at(reinterpret_cast<M*>(rec + payloadOffset<M>), std::forward<Args>(args)...);
+            writeHeader(pos, Header{ tagOf<M>(), static_cast<std::uint16_t>(need / kUnit) });
+            tail_pending_ = pos + need;
+            return true;
+        }
+
+        // One release store for every staged message
+        void publish() noexcept { tail_.store(tail_pending_, std::memory_order_release); }
+
+        std::size_t staged_bytes() const noexcept { return tail_pending_ - tail_.load(std::memory_order_relaxed); }
+
+        // ------------------------ Consumer ------------------------
+
+        // Handle the next message with f(M&); false if there is none
+        template <class F>
+        bool try_dispatch(F&& f)
+        {
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            std::size_t pos = head_.load(std::memory_order_relaxed);
+            try {
+                if (!dispatchOne(pos, tail, f)) return false;
+            } catch (...) {
+                head_.store(pos, std::memory_order_release);
+                throw;
+            }
+            head_.store(pos, std::memory_order_release);
+            return true;
+        }
+
+        // Handle up to max messages, then release them with one store; returns how many
+        template <class F>
+        std::size_t poll(F&& f, std::size_t max = std::numeric_limits<std::size_t>::max())
+        {
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            const std::size_t start = head_.load(std::memory_order_relaxed);
+            std::size_t pos = start;
+            std::size_t n = 0;
+            try {
+                while (n < max && dispatchOne(pos, tail, f)) ++n;
+            } catch (...) {
+                head_.store(pos, std::memory_order_release);      // the throwing message is consumed too
+                throw;
+            }
+            if (pos != start) head_.store(pos, std::memory_order_release);
+            return n;
+        }
+
+        bool empty() const noexcept
+        {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+    private:
+        Header header(std::size_t pos) const noexcept
+        {
+            Header h;
+            std::memcpy(&h, buf_ + (pos & mask_), sizeof(h));
+            return h;
+        }
+
+        void writeHeader(std::size_t pos, Header h) noexcept { std::memcpy(buf_ + (pos & mask_), &h, sizeof(h)); }
+
+        // Consumer: advance pos past the record at pos (and a pad before it), then run f on it
+        template <class F>
+        bool dispatchOne(std::size_t& pos, std::size_t tail, F& f)
+        {
+            if (pos == tail) return false;
+            Header h = header(pos);
+            if (h.tag == kPad) {
+                pos += std::size_t{ h.units } * kUnit;
+                h = header(pos);        // a pad is always published together with the record after it
+            }
+            std::byte* rec = buf_ + (pos & mask_);
+            pos += std::size_t{ h.units } * kUnit;     // consumed even if f throws: invokeOne destroys it
+            invokeTag(h.tag, rec, f, std::index_sequence_for<Ts...>{});
+            return true;
+        }
+
+        // Dense tags 0..N-1: lowered to a jump table
+        template <class F, std::size_t... I>
+        static void invokeTag(std::uint16_t tag, std::byte* rec, F& f, std::index_sequence<I...>)
+        {
+            (void)((tag == I ? (invokeOne<F, Ts>(rec, f), true) : false) || ...);
+        }
+
+        template <class F, class M>
+        static void invokeOne(std::byte* rec, F& f)
+        {
+            M* m = std::launder(reinterpret_cast<M*>(rec + payloadOffset<M>));
+            struct Guard { M* m; ~Guard() { std::destroy_at(m); } } guard{ m };    // destroyed even if f throws
+            f(*m);
+        }
+
+        template <class M>
+        static void destroyOne(std::byte* rec) noexcept
+        {
+            std::destroy_at(std::launder(reinterpret_cast<M*>(rec + payloadOffset<M>)));
+        }
+
+        static constexpr std::array<void (*)(std::byte*) noexcept, sizeof...(Ts)> kDestroy{ &destroyOne<Ts>... };
+
+        std::size_t cap_;
+        std::size_t mask_;
+        std::byte* buf_;
+        alignas(64) std::atomic<std::size_t> head_{ 0 };
+        alignas(64) std::atomic<std::size_t> tail_{ 0 };
+        alignas(64) std::size_t tail_pending_{ 0 };     // producer-private
+        std::size_t head_cache_{ 0 };
+    };
+
+} // namespace SPSC
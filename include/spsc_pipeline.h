@@ -0,0 +1,276 @@
+#pragma once
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+#include "spsc_ring.h"
+#include "spsc_wait.h"
+
+namespace SPSC {
+
+    struct PipelineOptions final
+    {
+        std::size_t ring_cap{ 1024 };   // every ring, rounded up to a power of two
+        std::size_t batch{ 32 };        // items a stage moves per publish
+        std::vector<int> cpus{};        // cpus[i] pins stage i; missing or < 0 = not pinned
+    };
+
+    // Pin a thread to one CPU; false if unsupported or refused
+    inline bool pinThread(std::thread::native_handle_type h, int cpu) noexcept
+    {
+        #if defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            return pthread_setaffinity_np(h, sizeof(set), &set) == 0;
+        #else
+            (void)h; (void)cpu;
+            return false;
+        #endif
+    }
+
+    /**
+     * @PushStage:  a stage that may emit zero or many outputs per input
+     * - opts in explicitly: derives from PushStageBase, so a functor that merely names an
+     *   out_type stays a function stage
+     * - in_type / out_type:  element types it takes and emits
+     * - operator()(in_type&&, emit) / finish(emit): emit(out_type&&) returns false once stopping
+     * - anything else is a plain 1:1 function stage, Out f(In&&)
+     */
+    struct PushStageBase {};
+
+    namespace Detail {
+        // Stand-in for the emit callable a Pipeline passes; only its signature matters
+        template <class Out>
+        struct EmitProbe final
+        {
+            bool operator()(Out&&) const noexcept { return true; }
+        };
+    }
+
+    template <class F>
+    concept PushStage = std::derived_from<F, PushStageBase> &&
+        requires(F& f, typename F::in_type&& v, Detail::EmitProbe<typename F::out_type>& emit) {
+            f(std::move(v), emit);
+            f.finish(emit);
+        };
+
+    namespace Detail {
+        template <class F, class T>
+        struct StageOut
+        {
+            using type = std::decay_t<std::invoke_result_t<F&, T&&>>;
+        };
+
+        template <PushStage F, class T>
+        struct StageOut<F, T>
+        {
+            using type = typename F::out_type;
+        };
+
+        // Element types along a chain: In, f0(In), f1(f0(In)), ...
+        template <class T, class... Fs>
+        struct Chain
+        {
+            using types = std::tuple<T>;
+        };
+
+        template <class T, class F, class... Fs>
+        struct Chain<T, F, Fs...>
+        {
+            using Next = typename StageOut<F, T>::type;
+            using types = decltype(std::tuple_cat(std::declval<std::tuple<T>>(),
+                                                  std::declval<typename Chain<Next, Fs...>::types>()));
+        };
+
+        template <class Tuple>
+        struct RingsOf;
+
+        template <class... Ts>
+        struct RingsOf<std::tuple<Ts...>>
+        {
+            using type = std::tuple<std::unique_ptr<SpscRing<Ts>>...>;
+        };
+    } // namespace Detail
+
+    /**
+     * @Pipeline:          thread-per-stage chain  caller -> [f0] -> [f1] -> ... -> [fk-1] -> caller
+     * @rings:             k + 1 SpscRings; ring i feeds stage i, ring k is the output
+     * @batching:          a stage stages up to batch outputs and publishes them with one store,
+     *                     publishing early whenever its input runs dry or its output fills
+     * @shutdown:
+     * - close():  no more input; each stage drains its ring, then marks itself done
+     * - drain(sink): close(), keep popping output() into sink until the last stage is
+     *             done (the caller must pop, or a full output ring would block it), join;
+     *             after stop() it returns once every stage thread has exited, handing over
+     *             whatever reached output() (finished() stays false)
+     * - stop():   request_stop on every jthread; stages exit after their current item,
+     *             leftovers are destroyed with the rings
+     * - destructor = stop()
+     * @ordering:
+     * - stage i stores done_[i+1] (release) only after its last publish, and stage i+1
+     *   loads done_[i+1] (acquire) *before* its final empty check, so the last items are seen
+     * - every stage bumps exited_ (release) on whichever path it leaves by; drain() reads it
+     *   the same way it reads finished()
+     * @threads:           push/close/try_pop/front: the caller thread only
+     */
+    template <class In, class Wait, class... Fs>
+    class Pipeline final
+    {
+        using Types = typename Detail::Chain<In, Fs...>::types;
+        static constexpr std::size_t kStages = sizeof...(Fs);
+
+        template <std::size_t I>
+        using TypeAt = std::tuple_element_t<I, Types>;
+
+    public:
+        using Out = TypeAt<kStages>;
+
+        explicit Pipeline(PipelineOptions opt, Fs... fs)
+            : opt_(std::move(opt)), fs_(std::move(fs)...)
+        {
+            if (!opt_.batch) opt_.batch = 1;
+            make_rings(std::make_index_sequence<kStages + 1>{});
+            start(std::make_index_sequence<kStages>{});
+        }
+
+        ~Pipeline() { stop(); }
+
+        Pipeline(const Pipeline&) = delete;
+        Pipeline& operator=(const Pipeline&) = delete;
+
+        SpscRing<In>& input() noexcept { return *std::get<0>(rings_); }
+        SpscRing<Out>& output() noexcept { return *std::get<kStages>(rings_); }
+
+        template <class U>
+        bool try_push(U&& v) { return input().try_push(std::forward<U>(v)); }
+        bool try_pop(Out& out) noexcept { return output().try_pop(out); }
+
+        void close() noexcept { done_[0].store(true, std::memory_order_release); }
+
+        // All stages finished; output() holds everything that was accepted
+        bool finished() const noexcept { return done_[kStages].load(std::memory_order_acquire); }
+
+        // close(), then hand every remaining output to sink(Out&&) until the last stage is done
+        template <class Sink>
+        void drain(Sink&& sink)
+        {
+            close();
+            Wait wait{};
+            Out v{};
+            for (;;) {
+                // Read finished() before the final sweep, same reasoning as the stage loop
+                const bool last = finished() || exited_.load(std::memory_order_acquire) == kStages;
+                while (output().try_pop(v)) { sink(std::move(v)); wait.reset(); }
+                if (last) break;
+                wait.wait();
+            }
+            for (auto& t : threads_) if (t.joinable()) t.join();
+        }
+
+        void stop()
+        {
+            for (auto& t : threads_) t.request_stop();
+            for (auto& t : threads_) if (t.joinable()) t.join();
+        }
+
+    private:
+        template <std::size_t... I>
+        void make_rings(std::index_sequence<I...>)
+        {
+            ((std::get<I>(rings_) = std::make_unique<SpscRing<TypeAt<I>>>(opt_.ring_cap)), ...);
+        }
+
+        template <std::size_t... I>
+        void start(std::index_sequence<I...>)
+        {
+            threads_.reserve(kStages);
+            (threads_.emplace_back([this](std::stop_token st) { run<I>(st); }), ...);
+            for (std::size_t i = 0; i < kStages && i < opt_.cpus.size(); ++i)
+                if (opt_.cpus[i] >= 0) pinThread(threads_[i].native_handle(), opt_.cpus[i]);
+        }
+
+        template <std::size_t I>
+        void run(std::stop_token st)
+        {
+            auto& in = *std::get<I>(rings_);
+            auto& out = *std::get<I + 1>(rings_);
+            auto& f = std::get<I>(fs_);
+            Wait wait{};
+
+            struct Exit final
+            {
+                std::atomic<std::size_t>& n;
+                ~Exit() { n.fetch_add(1, std::memory_order_release); }
+            } on_exit{ exited_ };
+
+            std::size_t burst = 0;
+            auto emit = [&](TypeAt<I + 1>&& v) -> bool {
+                while (!out.try_stage(std::move(v))) {
+                    if (burst) { out.publish(); burst = 0; }
+                    if (st.stop_requested()) return false;
+                    wait.wait();
+                }
+                if (++burst >= opt_.batch) { out.publish(); burst = 0; }
+                return true;
+            };
+
+            for (;;) {
+                TypeAt<I>* p = in.front();
+                if (!p) {
+                    if (burst) { out.publish(); burst = 0; }
+                    if (st.stop_requested()) return;
+                    // Acquire done first: the upstream's final publish happens-before it
+                    if (done_[I].load(std::memory_order_acquire) && !in.front()) break;
+                    wait.wait();
+                    continue;
+                }
+                wait.reset();
+
+                if constexpr (PushStage<std::tuple_element_t<I, std::tuple<Fs...>>>) {
+                    f(std::move(*p), emit);
+                    in.pop_front();
+                    if (st.stop_requested()) return;
+                } else {
+                    TypeAt<I + 1> v = std::invoke(f, std::move(*p));
+                    in.pop_front();
+                    if (!emit(std::move(v))) return;
+                }
+            }
+
+            if constexpr (PushStage<std::tuple_element_t<I, std::tuple<Fs...>>>) {
+                f.finish(emit);
+            }
+            if (burst) out.publish();
+            done_[I + 1].store(true, std::memory_order_release);
+        }
+
+        PipelineOptions opt_;
+        std::tuple<Fs...> fs_;
+        typename Detail::RingsOf<Types>::type rings_;
+        std::unique_ptr<std::atomic<bool>[]> done_{ std::make_unique<std::atomic<bool>[]>(kStages + 1) };
+        std::atomic<std::size_t> exited_{ 0 };
+        std::vector<std::jthread> threads_;
+    };
+
+    // Deduces stage types: makePipeline<In, Wait::Backoff>(opts, f0, f1, ...)
+    template <class In, class Wait = Wait::Backoff, class... Fs>
+    std::unique_ptr<Pipeline<In, Wait, std::decay_t<Fs>...>> makePipeline(PipelineOptions opt, Fs&&... fs)
+    {
+        return std::make_unique<Pipeline<In, Wait, std::decay_t<Fs>...>>(std::move(opt), std::forward<Fs>(fs)...);
+    }
+
+} // namespace SPSC
@@ -0,0 +1,158 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <sys/mman.h>
+
+namespace SPSC {
+
+    /**
+     * @policies:      SpscRing<T, Index, Storage, Wait, Stats> building blocks
+     * - every hook is a static constant or an inline no-op in the default, so a policy that is
+     *   not used leaves no load, store or byte behind
+     * - defaults (CachedIndex, HeapStorage, Wait::SpinPause, NoStats) are the ring as it was
+     */
+
+    // ------------------------ Index ------------------------
+    // Which side keeps a private copy of the other side's index
+
+    // Every push re-reads head_, every pop re-reads tail_
+    struct PlainIndex final
+    {
+        static constexpr bool cache_head = false;
+        static constexpr bool cache_tail = false;
+    };
+
+    // Producer caches head_ and reloads only when the cached view says full (the default)
+    struct CachedIndex final
+    {
+        static constexpr bool cache_head = true;
+        static constexpr bool cache_tail = false;
+    };
+
+    // CachedIndex plus a consumer-private tail cache: a burst of pops costs one acquire
+    struct DualCachedIndex final
+    {
+        static constexpr bool cache_head = true;
+        static constexpr bool cache_tail = true;
+    };
+
+    // ------------------------ Storage ------------------------
+    // Where slots come from and how far apart they are
+
+    // operator new, slots packed at alignof(T) (the default)
+    struct HeapStorage final
+    {
+        static constexpr std::size_t slot_align = 0;       // 0 = alignof(T)
+
+        static void* allocate(std::size_t bytes, std::size_t align)
+        {
+            return ::operator new(bytes, std::align_val_t(align));
+        }
+
+        static void deallocate(void* p, std::size_t bytes, std::size_t align) noexcept
+        {
+            ::operator delete(p, bytes, std::align_val_t(align));
+        }
+    };
+
+    // One slot per cache line: neighbouring slots never share a line (costs memory, no read_spans)
+    struct PaddedStorage final
+    {
+        static constexpr std::size_t slot_align = 64;
+
+        static void* allocate(std::size_t bytes, std::size_t align) { return HeapStorage::allocate(bytes, align); }
+        static void deallocate(void* p, std::size_t bytes, std::size_t align) noexcept { HeapStorage::deallocate(p, bytes, align); }
+    };
+
+    // 2 MiB pages: MAP_HUGETLB if the pool has pages, else an aligned mapping with MADV_HUGEPAGE
+    struct HugePageStorage final
+    {
+        static constexpr std::size_t slot_align = 0;
+        static constexpr std::size_t huge_page = std::size_t{ 2 } << 20;
+
+        static std::size_t mappedBytes(std::size_t bytes) noexcept { return (bytes + huge_page - 1) & ~(huge_page - 1); }
+
+        static void* allocate(std::size_t bytes, std::size_t)
+        {
+            const std::size_t len = mappedBytes(bytes);
+            #ifdef MAP_HUGETLB
+                void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (p != MAP_FAILED) return p;
+            #endif
+            // Over-map by one huge page so the region can start on a 2 MiB boundary
+            void* raw = ::mmap(nullptr, len + huge_page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) throw std::bad_alloc();
+            const auto base = reinterpret_cast<std::uintptr_t>(raw);
+            const auto aligned = (base + huge_page - 1) & ~(std::uintptr_t{ huge_page } - 1);
+            if (aligned != base) ::munmap(raw, aligned - base);
+            ::munmap(reinterpret_cast<void*>(aligned + len), huge_page - (aligned - base));
+            #ifdef MADV_HUGEPAGE
+                ::madvise(reinterpret_cast<void*>(aligned), len, MADV_HUGEPAGE);
+            #endif
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        static void deallocate(void* p, std::size_t bytes, std::size_t) noexcept
+        {
+            ::munmap(p, mappedBytes(bytes));
+        }
+    };
+
+    // ------------------------ Stats ------------------------
+    // Per-side counters; each side's block sits on that side's cache line
+
+    struct NoStats final
+    {
+        struct ProducerSide final
+        {
+            void on_push() noexcept {}
+            void on_full() noexcept {}
+        };
+        struct ConsumerSide final
+        {
+            void on_pop(std::size_t = 1) noexcept {}
+            void on_empty() noexcept {}
+        };
+        struct Snapshot final {};
+
+        static Snapshot snapshot(const ProducerSide&, const ConsumerSide&) noexcept { return {}; }
+    };
+
+    // Single-writer counters: relaxed load + store, no RMW; readable from any thread
+    struct RingStats final
+    {
+        struct ProducerSide final
+        {
+            std::atomic<std::uint64_t> pushes{ 0 };
+            std::atomic<std::uint64_t> full{ 0 };
+
+            void on_push() noexcept { pushes.store(pushes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+            void on_full() noexcept { full.store(full.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+        };
+        struct ConsumerSide final
+        {
+            std::atomic<std::uint64_t> pops{ 0 };
+            std::atomic<std::uint64_t> empty{ 0 };
+
+            void on_pop(std::size_t n = 1) noexcept { pops.store(pops.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+            void on_empty() noexcept { empty.store(empty.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+        };
+        struct Snapshot final
+        {
+            std::uint64_t pushes;       // accepted (staged counts)
+            std::uint64_t full;         // rejected pushes
+            std::uint64_t pops;
+            std::uint64_t empty;        // pops / fronts that found nothing
+        };
+
+        static Snapshot snapshot(const ProducerSide& p, const ConsumerSide& c) noexcept
+        {
+            return { p.pushes.load(std::memory_order_relaxed), p.full.load(std::memory_order_relaxed),
+                     c.pops.load(std::memory_order_relaxed), c.empty.load(std::memory_order_relaxed) };
+        }
+    };
+
+} // namespace SPSC
@@ -0,0 +1,236 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "spsc_doorbell.h"
+#include "spsc_pipeline.h"  // pinThread
+#include "spsc_ring.h"
+#include "spsc_wait.h"
+
+namespace SPSC {
+
+    // Fine-grained unit of work: trivially copyable, moves between rings by value
+    struct Task final
+    {
+        void (*fn)(void*) { nullptr };
+        void* arg{ nullptr };
+
+        void operator()() const { fn(arg); }
+    };
+
+    /**
+     * @StealPool:     task pool where every queue is an SpscRing
+     * @fast_path:     submitter -> inbox(i) -> worker i; no RMW, no shared counters
+     * @stealing:
+     * - idle worker t sends one StealRequest over request(t -> v) and rings v's doorbell
+     * - victim v checks its doorbell between tasks (one relaxed load while nobody is stealing),
+     *   pops up to half of its inbox (it is that ring's consumer) and replies over reply(v -> t)
+     * - at most one request per thief is outstanding; an empty reply moves it to the next victim
+     * - stolen tasks run from the thief's private stash, ahead of its own (empty) inbox
+     * @threads:       submit/wait_idle: one submitter thread; workers are internal
+     */
+    template <class Wait = Wait::Backoff, std::size_t StealBatch = 32>
+    class StealPool final
+    {
+        struct StealRequest final
+        {
+            std::uint32_t want;
+        };
+
+        struct StealReply final
+        {
+            std::uint32_t count{ 0 };
+            Task tasks[StealBatch];
+        };
+
+        struct alignas(64) Worker final
+        {
+            std::unique_ptr<SpscRing<Task>> inbox;
+            std::atomic<std::uint64_t> done{ 0 };
+            std::atomic<std::uint64_t> stolen{ 0 };    // tasks received through steal replies
+        };
+
+    public:
+        struct Options final
+        {
+            std::size_t workers{ 2 };
+            std::size_t inbox_cap{ 4096 };
+            std::vector<int> cpus{};        // cpus[i] pins worker i; < 0 = not pinned
+        };
+
+        explicit StealPool(Options opt)
+            : opt_(std::move(opt)), n_(opt_.workers < 1 ? 1 : opt_.workers),
+              workers_(std::make_unique<Worker[]>(n_))
+        {
+            requests_.resize(n_ * n_);
+            replies_.resize(n_ * n_);
+            doorbells_.reserve(n_);
+            for (std::size_t i = 0; i < n_; ++i) {
+                workers_[i].inbox = std::make_unique<SpscRing<Task>>(opt_.inbox_cap);
+                doorbells_.push_back(std::make_unique<Doorbell>(n_));
+                for (std::size_t j = 0; j < n_; ++j) {
+                    if (i == j) continue;
+                    requests_[i * n_ + j] = std::make_unique<SpscRing<StealRequest>>(2);
+                    replies_[i * n_ + j] = std::make_unique<SpscRing<StealReply>>(2);
+                }
+            }
+            threads_.reserve(n_);
+            for (std::size_t i = 0; i < n_; ++i)
+                threads_.emplace_back([this, i](std::stop_token st) { run(i, st); });
+            for (std::size_t i = 0; i < n_ && i < opt_.cpus.size(); ++i)
+                if (opt_.cpus[i] >= 0) pinThread(threads_[i].native_handle(), opt_.cpus[i]);
+        }
+
+        ~StealPool()
+        {
+            for (auto& t : threads_) t.request_stop();
+            for (auto& t : threads_) if (t.joinable()) t.join();
+        }
+
+        StealPool(const StealPool&) = delete;
+        StealPool& operator=(const StealPool&) = delete;
+
+        std::size_t workers() const noexcept { return n_; }
+
+        // Submitter Thread: round-robin, skipping full inboxes; false if every inbox is full
+        bool submit(Task t)
+        {
+            for (std::size_t k = 0; k < n_; ++k) {
+                std::size_t i = next_ + k < n_ ? next_ + k : next_ + k - n_;
+                if (workers_[i].inbox->try_push(t)) {
+                    next_ = i + 1 == n_ ? 0 : i + 1;
+                    ++submitted_;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Submitter Thread: target one worker (e.g. for affinity); stealing rebalances it
+        bool submit_to(std::size_t worker, Task t)
+        {
+            if (!workers_[worker].inbox->try_push(t)) return false;
+            ++submitted_;
+            return true;
+        }
+
+        std::uint64_t completed() const noexcept
+        {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n_; ++i) sum += workers_[i].done.load(std::memory_order_acquire);
+            return sum;
+        }
+
+        std::uint64_t stolen() const noexcept
+        {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n_; ++i) sum += workers_[i].stolen.load(std::memory_order_relaxed);
+            return sum;
+        }
+
+        // Submitter Thread: block until every submitted task has run
+        void wait_idle() const
+        {
+            Wait wait{};
+            while (completed() != submitted_) wait.wait();
+        }
+
+    private:
+        void run(std::size_t me, std::stop_token st)
+        {
+            SpscRing<Task>& inbox = *workers_[me].inbox;
+            std::atomic<std::uint64_t>& done = workers_[me].done;
+            Doorbell& bell = *doorbells_[me];
+            Wait wait{};
+
+            StealReply stash{};
+            std::size_t stash_pos = 0;
+            std::size_t victim = me;
+            bool pending = false;
+            std::uint64_t ran = 0;
+
+            auto finish = [&] { done.store(++ran, std::memory_order_release); };
+
+            while (!st.stop_requested()) {
+                serve(me, inbox, bell);
+
+                if (Task* t = inbox.front()) {
+                    Task task = *t;
+                    inbox.pop_front();
+                    task();
+                    finish();
+                    wait.reset();
+                    continue;
+                }
+                if (stash_pos < stash.count) {
+                    stash.tasks[stash_pos++]();
+                    finish();
+                    wait.reset();
+                    continue;
+                }
+                if (n_ == 1) { wait.wait(); continue; }
+
+                if (!pending) {
+                    victim = victim + 1 == n_ ? 0 : victim + 1;
+                    if (victim == me) victim = victim + 1 == n_ ? 0 : victim + 1;
+                    if (requests_[me * n_ + victim]->try_push(StealRequest{ StealBatch })) {
+                        doorbells_[victim]->ring(me);
+                        pending = true;
+                    }
+                } else if (StealReply* r = replies_[victim * n_ + me]->front()) {
+                    stash = *r;
+                    stash_pos = 0;
+                    replies_[victim * n_ + me]->pop_front();
+                    pending = false;
+                    if (stash.count) {
+                        workers_[me].stolen.fetch_add(stash.count, std::memory_order_relaxed);
+                        continue;
+                    }
+                }
+                wait.wait();
+            }
+        }
+
+        // Victim side: answer every thief whose bit is set
+        void serve(std::size_t me, SpscRing<Task>& inbox, Doorbell& bell)
+        {
+            for (std::size_t w = 0; w < bell.words(); ++w) {
+                for (std::uint64_t bits = bell.take(w); bits; bits &= bits - 1) {
+                    const std::size_t thief = w * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                    SpscRing<StealRequest>& req = *requests_[thief * n_ + me];
+                    for (StealRequest* q; (q = req.front());) {
+                        StealReply reply{};
+                        const std::size_t half = (inbox.size() + 1) / 2;
+                        const std::size_t take = std::min<std::size_t>({ half, q->want, StealBatch });
+                        for (Task* t; reply.count < take && (t = inbox.front());) {
+                            reply.tasks[reply.count++] = *t;
+                            inbox.pop_front();
+                        }
+                        req.pop_front();
+                        // One request outstanding per thief and a 2-slot ring: always room
+                        replies_[me * n_ + thief]->try_push(reply);
+                    }
+                }
+            }
+        }
+
+        Options opt_;
+        std::size_t n_;
+        std::unique_ptr<Worker[]> workers_;
+        std::vector<std::unique_ptr<SpscRing<StealRequest>>> requests_;     // [thief * n + victim]
+        std::vector<std::unique_ptr<SpscRing<StealReply>>> replies_;        // [victim * n + thief]
+        std::vector<std::unique_ptr<Doorbell>> doorbells_;
+        std::vector<std::jthread> threads_;
+        std::size_t next_{ 0 };
+        std::uint64_t submitted_{ 0 };
+    };
+
+} // namespace SPSC
@@ -0,0 +1,134 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    template <class T>
+    struct Sequenced final
+    {
+        std::uint64_t seq;
+        T value;
+    };
+
+    /**
+     * @ReorderStage:      fan a stream out to N workers and restore input order on the way back
+     * @rings:
+     * - to_worker(i):   stage -> worker i, carries Sequenced<In>
+     * - from_worker(i): worker i -> stage, carries Sequenced<Out> (seq copied through unchanged)
+     * @window:
+     * - power-of-two array of Out slots indexed by seq & (window - 1)
+     * - dispatch() refuses once window items are in flight, so two live seqs never share a slot
+     * @threads:
+     * - dispatch/poll: the stage thread (producer of to_worker, consumer of from_worker)
+     * - worker i: consumer of to_worker(i), producer of from_worker(i)
+     */
+    template <class In, class Out = In>
+    class ReorderStage final
+    {
+        struct Slot final
+        {
+            alignas(Out) std::byte obj_buf[sizeof(Out)];
+            bool ready{ false };
+
+            Out* raw() noexcept { return reinterpret_cast<Out*>(obj_buf); }
+            Out* obj() noexcept { return std::launder(reinterpret_cast<Out*>(obj_buf)); }
+        };
+
+    public:
+        explicit ReorderStage(std::size_t workers, std::size_t ring_cap, std::size_t window)
+        {
+            const std::size_t w = BitOps::roundCap(window);
+            window_ = std::make_unique<Slot[]>(w);
+            mask_ = w - 1;
+
+            for (std::size_t i = 0; i < (workers ? workers : 1); ++i) {
+                out_.push_back(std::make_unique<SpscRing<Sequenced<In>>>(ring_cap));
+                back_.push_back(std::make_unique<SpscRing<Sequenced<Out>>>(ring_cap));
+            }
+        }
+
+        ~ReorderStage() noexcept
+        {
+            for (std::size_t i = 0; i <= mask_; ++i)
+                if (window_[i].ready) std::destroy_at(window_[i].obj());
+        }
+
+        ReorderStage(const ReorderStage&) = delete;
+        ReorderStage& operator=(const ReorderStage&) = delete;
+
+        std::size_t workers() const noexcept { return out_.size(); }
+        std::size_t window() const noexcept { return mask_ + 1; }
+        std::size_t in_flight() const noexcept { return static_cast<std::size_t>(next_seq_ - emit_seq_); }
+
+        SpscRing<Sequenced<In>>& to_worker(std::size_t i) noexcept { return *out_[i]; }
+        SpscRing<Sequenced<Out>>& from_worker(std::size_t i) noexcept { return *back_[i]; }
+
+        // Stage Thread: tag and send to the next worker with room; false = window or rings full
+        template <class U>
+        bool dispatch(U&& v)
+        {
+            if (in_flight() > mask_) return false;
+
+            // Built once: a failed try_push leaves its argument untouched
+            Sequenced<In> tagged{ next_seq_, In(std::forward<U>(v)) };
+            const std::size_t n = out_.size();
+            for (std::size_t k = 0; k < n; ++k) {
+                std::size_t i = rr_ + k < n ? rr_ + k : rr_ + k - n;
+                if (out_[i]->try_push(std::move(tagged))) {
+                    ++next_seq_;
+                    rr_ = i + 1 == n ? 0 : i + 1;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @poll:  Stage Thread; park returned results, then emit the contiguous prefix in order
+         * - emit(Out&&) is called for each in-order result; returns how many were emitted
+         */
+        template <class Emit>
+        std::size_t poll(Emit&& emit)
+        {
+            Sequenced<Out> r{};
+            for (auto& ring : back_) {
+                while (ring->try_pop(r)) {
+                    Slot& s = window_[r.seq & mask_];
+                    std::construct_at(s.raw(), std::move(r.value));
+                    s.ready = true;
+                }
+            }
+
+            std::size_t emitted = 0;
+            for (;;) {
+                Slot& s = window_[emit_seq_ & mask_];
+                if (!s.ready) break;
+                Out* o = s.obj();
+                emit(std::move(*o));
+                std::destroy_at(o);
+                s.ready = false;
+                ++emit_seq_;
+                ++emitted;
+            }
+            return emitted;
+        }
+
+    private:
+        std::vector<std::unique_ptr<SpscRing<Sequenced<In>>>> out_;
+        std::vector<std::unique_ptr<SpscRing<Sequenced<Out>>>> back_;
+        std::unique_ptr<Slot[]> window_;
+        std::size_t mask_{ 0 };
+        std::uint64_t next_seq_{ 0 };   // next tag handed out
+        std::uint64_t emit_seq_{ 0 };   // next tag owed downstream
+        std::size_t rr_{ 0 };
+    };
+
+} // namespace SPSC
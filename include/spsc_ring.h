@@ -4,6 +4,8 @@
 #include <memory>
 #include <new>   // std::hardware_destructive_interfence_size
 #include <concepts>
+#include <span>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -11,11 +13,16 @@
 // -- For Log Table --
 #include <array>
 #include <cstdint>
+#include <cstring>  // std::memcpy (async-signal-safe)
+#include <limits>
 // #include <type_traits>
 #if __has_include(<bit>)
     #include <bit>  // C++ 20: countl_zero, bit_cell (optional fast path)
 #endif
 
+#include "spsc_policy.h"
+#include "spsc_wait.h"
+
 namespace SPSC {
     namespace BitOps {
         // -----------  1) Byte log2 table (constexpr, header-safe) -----------
@@ -86,8 +93,99 @@ namespace SPSC {
                 return v + 1;
             #endif
         }
+
+        // Ring capacity: cap rounded up to a power of two (0 -> 1); 0 when that exceeds size_t
+        constexpr std::size_t roundCap(std::size_t cap) noexcept
+        {
+            if (isPow2(cap)) return cap;
+            if (cap > (std::numeric_limits<std::size_t>::max() >> 1) + 1) return 0;
+            return static_cast<std::size_t>(ceilPow2(static_cast<std::uint64_t>(cap)));
+        }
     } // namespace BitOps
 
+    namespace Detail {
+        /**
+         * @RoleBaton:  release/acquire hand-over point for one ring role (producer or consumer)
+         * - only the current holder calls handoff(); the epoch it returns names that handoff
+         * - try_adopt(h) succeeds once handoff h (or a later one) is visible, and from then on
+         *   everything the old holder did happens-before the adopter's next step
+         */
+        struct alignas(64) RoleBaton final
+        {
+            std::atomic<std::uint32_t> epoch{ 0 };
+
+            std::uint32_t handoff() noexcept
+            {
+                const std::uint32_t e = epoch.load(std::memory_order_relaxed) + 1;
+                epoch.store(e, std::memory_order_release);
+                return e;
+            }
+
+            bool try_adopt(std::uint32_t h) const noexcept
+            {
+                return static_cast<std::int32_t>(epoch.load(std::memory_order_acquire) - h) >= 0;
+            }
+
+            void adopt(std::uint32_t h) const noexcept
+            {
+                while (!try_adopt(h)) std::this_thread::yield();
+            }
+        };
+
+        struct Unused final {};
+
+        // Process-unique, never reused: unlike `this`, a new object at a dead one's address gets its own
+        inline std::uint64_t nextInstanceId() noexcept
+        {
+            static std::atomic<std::uint64_t> next{ 0 };
+            return next.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        /**
+         * @ThreadRoles:  per-thread table of the role (V) this thread holds in each Owner instance
+         * - keyed by instance id, so a thread switching between instances finds its old role again
+         *   and an instance rebuilt at the same address starts with none
+         * - the last entry used is moved to the front: the steady state is one compare
+         * - one entry per instance the thread ever used; ids of dead instances never match again
+         */
+        template <class Owner, class V>
+        struct ThreadRoles final
+        {
+            struct Entry final
+            {
+                std::uint64_t id;
+                V role;
+            };
+
+            static V* find(std::uint64_t id) noexcept
+            {
+                auto& e = entries();
+                if (!e.empty() && e.front().id == id) return &e.front().role;
+                for (std::size_t i = 1; i < e.size(); ++i) {
+                    if (e[i].id != id) continue;
+                    std::swap(e.front(), e[i]);
+                    return &e.front().role;
+                }
+                return nullptr;
+            }
+
+            static V& add(std::uint64_t id, V role)
+            {
+                auto& e = entries();
+                e.push_back(Entry{ id, role });
+                std::swap(e.front(), e.back());
+                return e.front().role;
+            }
+
+        private:
+            static std::vector<Entry>& entries() noexcept
+            {
+                static thread_local std::vector<Entry> e;
+                return e;
+            }
+        };
+    } // namespace Detail
+
     /**
      * @storage:    raw byte array (for in-place construction)
      * @alignment:  alignas(T) std::byte storage_[sizeof(T) * capacity]
@@ -110,13 +208,24 @@ namespace SPSC {
      * - need to access object: indexed-based - operator[]
      * - 
      * 
+     * @policies:   (spsc_policy.h)
+     * - Index:      PlainIndex | CachedIndex | DualCachedIndex - which side caches the other's index
+     * - Storage:    HeapStorage | PaddedStorage | HugePageStorage - slot allocation and stride
+     * - WaitPolicy: what push()/pop() do between failed attempts (spsc_wait.h)
+     * - Stats:      NoStats | RingStats - per-side counters, snapshot via stats()
      *
     */
 
-    template <class T>
+    template <class T,
+              class Index = CachedIndex,
+              class Storage = HeapStorage,
+              class WaitPolicy = Wait::SpinPause,
+              class Stats = NoStats>
     class SpscRing final
     {
-        struct Slot final
+        static constexpr std::size_t slot_align = Storage::slot_align > alignof(T) ? Storage::slot_align : alignof(T);
+
+        struct alignas(slot_align) Slot final
         {
             alignas(T) std::byte obj_buf[sizeof(T)];
 
@@ -125,7 +234,7 @@ namespace SPSC {
                 return reinterpret_cast<T*>(obj_buf);
             }
 
-            const T* obj() noexcept const {
+            const T* obj() const noexcept {
                 return std::launder(reinterpret_cast<const T*>(obj_buf));
             }
 
@@ -140,19 +249,32 @@ namespace SPSC {
         explicit SpscRing() : SpscRing(1) {}
         explicit SpscRing(std::size_t cap)
         {
-            std::size_t cap_checked = (BitOps::isPow2(static_cast<uint64_t>(cap)) ? cap : 
-                static_cast<std::size_t>(BitOps::ceilPow2(static_cast<uint64_t>(cap))));
-            buffer_ = new Slot[cap_checked];
+            std::size_t cap_checked = BitOps::roundCap(cap);
+            buffer_ = static_cast<Slot*>(Storage::allocate(sizeof(Slot) * cap_checked, alignof(Slot)));
             cap_ = cap_checked;
 
         } 
 
+        /**
+         * @external_storage:   slots placed in caller memory (arena, NUMA-bound or huge pages)
+         * - storage: at least storage_bytes(cap) bytes aligned to storage_align; must outlive the ring
+         * - the ring destroys live elements but never frees storage
+         */
+        explicit SpscRing(std::size_t cap, void* storage) noexcept
+            : cap_(BitOps::roundCap(cap)), owns_buffer_(false)
+        {
+            buffer_ = std::launder(reinterpret_cast<Slot*>(storage));
+        }
+
+        static constexpr std::size_t storage_align = alignof(Slot);
+        static constexpr std::size_t storage_bytes(std::size_t cap) noexcept { return sizeof(Slot) * BitOps::roundCap(cap); }
+
         ~SpscRing() noexcept {
             if (!buffer_) return;
             auto h = head_.load(std::memory_order_relaxed);
-            auto t = tail_.load(std::memory_order_relaxed);
+            auto t = tail_pending_;     // staged-but-unpublished objects are live too
             while (h != t) { std::destroy_at(buffer_[h].obj()); h = (h + 1) & (cap_ - 1); }
-            delete[] buffer_;
+            if (owns_buffer_) Storage::deallocate(buffer_, sizeof(Slot) * cap_, alignof(Slot));
         }
 
 
@@ -183,23 +305,15 @@ namespace SPSC {
         // std::memory_order_relaxed
         bool try_push(const T& v) noexcept(noexcept(T(v)))
         {
-            std::size_t tail = tail_.load(std::memory_order_relaxed);
-            std::size_t tail_next = (tail + 1) & (cap_ - 1);
-
-            if (tail_next == head_.load(std::memory_order_acquire))  return false;
-            std::construct_at(buffer_[tail].raw(), v);
-            tail_.store(tail_next, std::memory_order_release);
+            if (!try_stage(v)) return false;
+            publish();
             return true;
         }
 
         bool try_push(T&& v) noexcept(noexcept(T(std::move(v)))) 
         {
-            std::size_t tail = tail_.load(std::memory_order_relaxed);
-            std::size_t tail_next = (tail + 1) & (cap_ - 1);
-
-            if (tail_next == head_.load(std::memory_order_acquire))  return false;
-            std::construct_at(buffer_[tail].raw(), std::move(v));
-            tail_.store(tail_next, std::memory_order_release);
+            if (!try_stage(std::move(v))) return false;
+            publish();
             return true;
         }
 
@@ -207,29 +321,213 @@ namespace SPSC {
             requires std::constructible_from<T, Args...>
         bool try_emplace(Args&&... args) noexcept
         {
-            std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (!try_stage(std::forward<Args>(args)...)) return false;
+            publish();
+            return true;
+        }
+
+        // Producer Thread: try_push until it succeeds, WaitPolicy between attempts
+        void push(const T& v) noexcept(noexcept(T(v)))
+        {
+            WaitPolicy wait{};
+            while (!try_push(v)) wait.wait();
+        }
+
+        void push(T&& v) noexcept(noexcept(T(std::move(v))))
+        {
+            WaitPolicy wait{};
+            while (!try_push(std::move(v))) wait.wait();     // moved from only on success
+        }
+
+        /**
+         * @try_stage:  construct at the producer's pending tail without publishing it
+         * - consumer cannot observe the element until publish()
+         * - lets a producer amortize one release store over a burst
+         */
+        template <class... Args>
+            requires std::constructible_from<T, Args...>
+        bool try_stage(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        {
+            std::size_t tail = tail_pending_;
             std::size_t tail_next = (tail + 1) & (cap_ - 1);
-            if (tail_next == head_.load(std::memory_order_acquire)) return false;
+            if (!writable(tail_next)) { pstats_.on_full(); return false; }
 
             std::construct_at(buffer_[tail].raw(), std::forward<Args>(args)...);
+            tail_pending_ = tail_next;
+            pstats_.on_push();
+            return true;
+        }
+
+        /**
+         * @try_push_signal_safe:   producer path that may run inside a signal handler
+         * - T trivially copyable: the slot is filled with memcpy, no constructor runs, nothing throws
+         * - no allocation, no locks; the index atomics are checked lock-free at compile time
+         * - the handler must be the ring's only producer: e.g. one ring per thread, written only
+         *   by that thread's handler, so it never interrupts a try_push on the same ring
+         */
+        bool try_push_signal_safe(const T& v) noexcept
+            requires std::is_trivially_copyable_v<T>
+        {
+            static_assert(std::atomic<std::size_t>::is_always_lock_free,
+                "signal-safe push needs lock-free index atomics");
+
+            std::size_t tail = tail_pending_;
+            std::size_t tail_next = (tail + 1) & (cap_ - 1);
+            if (!writable(tail_next)) { pstats_.on_full(); return false; }
+
+            std::memcpy(buffer_[tail].obj_buf, std::addressof(v), sizeof(T));
+            tail_pending_ = tail_next;
             tail_.store(tail_next, std::memory_order_release);
+            pstats_.on_push();
             return true;
         }
 
+        // Producer Thread: release every staged element in one store
+        void publish() noexcept { tail_.store(tail_pending_, std::memory_order_release); }
+
+        /**
+         * @producer_size:  occupancy as seen through the producer's cached head
+         * - no cross-core read; an upper bound that is stale by whatever was popped since refresh
+         */
+        std::size_t producer_size() const noexcept
+            requires Index::cache_head
+        {
+            return (tail_pending_ - head_cache_) & (cap_ - 1);
+        }
+
+        // Producer Thread: re-read head_ into the cache (one acquire load of the consumer's line)
+        std::size_t refresh_head() noexcept
+            requires Index::cache_head
+        {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            return producer_size();
+        }
+
+        // Producer Thread: elements constructed but not yet visible to the consumer
+        std::size_t staged() const noexcept
+        {
+            return (tail_pending_ - tail_.load(std::memory_order_relaxed)) & (cap_ - 1);
+        }
+
         bool try_pop(T& out) noexcept 
         {
             const std::size_t head = head_.load(std::memory_order_relaxed);
-            if (head == tail_.load(std::memory_order_acquire)) return false;
+            if (!readable(head)) { consumer_.stats.on_empty(); return false; }
 
             T* object = buffer_[head].obj();
             out = std::move(*object);
             std::destroy_at(object);
 
             head_.store((head + 1) & (cap_ - 1), std::memory_order_release);
+            consumer_.stats.on_pop();
             return true;
         }
 
+        // Consumer Thread: try_pop until it succeeds, WaitPolicy between attempts
+        void pop(T& out) noexcept
+        {
+            WaitPolicy wait{};
+            while (!try_pop(out)) wait.wait();
+        }
+
+        // Consumer Thread: head element in place (nullptr if empty); valid until pop_front()
+        T* front() noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (!readable(head)) { consumer_.stats.on_empty(); return nullptr; }
+            return buffer_[head].obj();
+        }
+
+        // Consumer Thread: destroy the head element (pre-condition: front() != nullptr)
+        void pop_front() noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            std::destroy_at(buffer_[head].obj());
+            head_.store((head + 1) & (cap_ - 1), std::memory_order_release);
+            consumer_.stats.on_pop();
+        }
+
+        /**
+         * @read_spans:     every published element as at most two contiguous runs (head..end, 0..tail)
+         * - T trivially copyable: slots are laid out as a plain T array, so the spans can go
+         *   straight into writev()/memcpy without touching each element
+         * - valid until consume(); consume(n) releases the first n elements with one store
+         */
+        struct ReadSpans final
+        {
+            std::span<T> first;
+            std::span<T> second;
+
+            std::size_t size() const noexcept { return first.size() + second.size(); }
+        };
+
+        // Consumer Thread: snapshot of the readable region
+        ReadSpans read_spans() noexcept
+            requires std::is_trivially_copyable_v<T>
+        {
+            static_assert(sizeof(Slot) == sizeof(T), "slots must be a dense T array");
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            if constexpr (Index::cache_tail) consumer_.tail_cache = tail;
+            T* base = std::launder(reinterpret_cast<T*>(buffer_));
+            if (tail >= head) return { { base + head, tail - head }, {} };
+            return { { base + head, cap_ - head }, { base, tail } };
+        }
+
+        // Consumer Thread: drop n elements from the head (pre-condition: n <= readable)
+        void consume(std::size_t n) noexcept
+        {
+            std::size_t head = head_.load(std::memory_order_relaxed);
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                for (std::size_t i = 0; i < n; ++i) std::destroy_at(buffer_[(head + i) & (cap_ - 1)].obj());
+            head_.store((head + n) & (cap_ - 1), std::memory_order_release);
+            consumer_.stats.on_pop(n);
+        }
+
+        // Counters from the Stats policy (an empty Snapshot for NoStats); any thread
+        typename Stats::Snapshot stats() const noexcept { return Stats::snapshot(pstats_, consumer_.stats); }
+
+        /**
+         * @role_migration: move the producer or the consumer to another thread without draining
+         * - old thread, after its last call in that role: h = handoff_producer()
+         * - new thread, before its first: adopt_producer(h) (yields until the handoff is visible)
+         * - the producer's private tail_pending_/head_cache_ travel with it: staged elements stay
+         *   staged and are published by the new thread; the consumer picks up head_ where it was
+         * - h can reach the new thread any way at all (scheduler queue, plain store); the baton
+         *   provides the ordering, not the channel that carried h
+         */
+        std::uint32_t handoff_producer() noexcept { return producer_role_.handoff(); }
+        bool try_adopt_producer(std::uint32_t h) const noexcept { return producer_role_.try_adopt(h); }
+        void adopt_producer(std::uint32_t h) const noexcept { producer_role_.adopt(h); }
+
+        std::uint32_t handoff_consumer() noexcept { return consumer_role_.handoff(); }
+        bool try_adopt_consumer(std::uint32_t h) const noexcept { return consumer_role_.try_adopt(h); }
+        void adopt_consumer(std::uint32_t h) const noexcept { consumer_role_.adopt(h); }
+
     private:
+        // Producer: is the slot before tail_next free? Touches the consumer's line only when it must
+        bool writable(std::size_t tail_next) noexcept
+        {
+            if constexpr (Index::cache_head) {
+                if (tail_next != head_cache_) return true;
+                head_cache_ = head_.load(std::memory_order_acquire);
+                return tail_next != head_cache_;
+            } else {
+                return tail_next != head_.load(std::memory_order_acquire);
+            }
+        }
+
+        // Consumer: is there an element at head?
+        bool readable(std::size_t head) noexcept
+        {
+            if constexpr (Index::cache_tail) {
+                if (head != consumer_.tail_cache) return true;
+                consumer_.tail_cache = tail_.load(std::memory_order_acquire);
+                return head != consumer_.tail_cache;
+            } else {
+                return head != tail_.load(std::memory_order_acquire);
+            }
+        }
 
         #ifdef __cpp_lib_hardware_interference_size
             inline static constexpr std::size_t cache_align = std::hardware_destructive_interference_size;
@@ -239,10 +537,31 @@ namespace SPSC {
         #endif
 
 
+        // Consumer-private line; collapses to nothing when neither the index nor the stats need it
+        static constexpr bool consumer_local = Index::cache_tail || !std::is_empty_v<typename Stats::ConsumerSide>;
+
+        struct alignas(cache_align) ConsumerLocal final
+        {
+            [[no_unique_address]] std::conditional_t<Index::cache_tail, std::size_t, Detail::Unused> tail_cache{};
+            [[no_unique_address]] typename Stats::ConsumerSide stats{};
+        };
+
+        struct ConsumerNone final
+        {
+            [[no_unique_address]] typename Stats::ConsumerSide stats{};
+        };
+
         std::size_t cap_;
         alignas(cache_align) std::atomic<std::size_t> head_{ 0 };
         alignas(cache_align) std::atomic<std::size_t> tail_{ 0 };
+        alignas(cache_align) std::size_t tail_pending_{ 0 };    // producer-private
+        [[no_unique_address]] std::conditional_t<Index::cache_head, std::size_t, Detail::Unused> head_cache_{};  // producer's last view of head_
+        [[no_unique_address]] typename Stats::ProducerSide pstats_{};
         Slot *buffer_{ nullptr };
+        bool owns_buffer_{ true };
+        [[no_unique_address]] std::conditional_t<consumer_local, ConsumerLocal, ConsumerNone> consumer_{};
+        Detail::RoleBaton producer_role_{};     // cold: touched only on migration
+        Detail::RoleBaton consumer_role_{};
 
     };
 
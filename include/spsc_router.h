@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    /**
+     * @ShortestQueueRouter:   join-shortest-queue over N SpscRings for order-independent work
+     * @estimate:
+     * - per ring producer_size(): producer's own tail vs. its cached copy of head_
+     * - routing a push reads only producer-private state (no consumer cache lines)
+     * @refresh:
+     * - every refresh_every pushes, each ring's cached head is re-read (N acquire loads)
+     * - a push that finds its pick full refreshes every ring and retries once
+     * - refresh_every == 0 disables the periodic refresh (heads refresh only on full)
+     * @ties:              scan starts one past the last pick so equal lanes rotate
+     * @threads:           push: the single producer; ring(i).try_pop: worker i only
+     */
+    template <class T>
+    class ShortestQueueRouter final
+    {
+    public:
+        explicit ShortestQueueRouter(std::size_t rings, std::size_t ring_cap, std::size_t refresh_every = 64)
+            : refresh_every_(refresh_every)
+        {
+            rings_.reserve(rings ? rings : 1);
+            for (std::size_t i = 0; i < (rings ? rings : 1); ++i)
+                rings_.push_back(std::make_unique<SpscRing<T>>(ring_cap));
+        }
+
+        ShortestQueueRouter(const ShortestQueueRouter&) = delete;
+        ShortestQueueRouter& operator=(const ShortestQueueRouter&) = delete;
+
+        std::size_t rings() const noexcept { return rings_.size(); }
+        SpscRing<T>& ring(std::size_t i) noexcept { return *rings_[i]; }
+
+        std::size_t refresh_every() const noexcept { return refresh_every_; }
+        void set_refresh_every(std::size_t n) noexcept { refresh_every_ = n; }
+
+        // Lane the next push would pick, from cached state only
+        std::size_t pick() const noexcept
+        {
+            const std::size_t n = rings_.size();
+            std::size_t best = last_ + 1 == n ? 0 : last_ + 1;
+            std::size_t best_size = rings_[best]->producer_size();
+            for (std::size_t k = 1; k < n && best_size; ++k) {
+                std::size_t i = best + k < n ? best + k : best + k - n;
+                std::size_t sz = rings_[i]->producer_size();
+                if (sz < best_size) { best = i; best_size = sz; }
+            }
+            return best;
+        }
+
+        // Returns the lane used, or rings() if every ring is full after a refresh
+        template <class... Args>
+        std::size_t push(Args&&... args)
+        {
+            if (refresh_every_ && ++since_refresh_ >= refresh_every_) refresh();
+
+            std::size_t i = pick();
+            if (!rings_[i]->try_emplace(std::forward<Args>(args)...)) {
+                // Estimate was stale (or everything is full): resync and retry once;
+                // a failed try_emplace never constructs, so args are still intact
+                refresh();
+                i = pick();
+                if (!rings_[i]->try_emplace(std::forward<Args>(args)...)) return rings_.size();
+            }
+            last_ = i;
+            return i;
+        }
+
+        void refresh() noexcept
+        {
+            for (auto& r : rings_) r->refresh_head();
+            since_refresh_ = 0;
+        }
+
+    private:
+        std::vector<std::unique_ptr<SpscRing<T>>> rings_;
+        std::size_t refresh_every_;
+        std::size_t since_refresh_{ 0 };
+        std::size_t last_{ 0 };
+    };
+
+    /**
+     * @RoundRobinRouter:  baseline for ShortestQueueRouter (same interface, blind rotation)
+     */
+    template <class T>
+    class RoundRobinRouter final
+    {
+    public:
+        explicit RoundRobinRouter(std::size_t rings, std::size_t ring_cap)
+        {
+            rings_.reserve(rings ? rings : 1);
+            for (std::size_t i = 0; i < (rings ? rings : 1); ++i)
+                rings_.push_back(std::make_unique<SpscRing<T>>(ring_cap));
+        }
+
+        RoundRobinRouter(const RoundRobinRouter&) = delete;
+        RoundRobinRouter& operator=(const RoundRobinRouter&) = delete;
+
+        std::size_t rings() const noexcept { return rings_.size(); }
+        SpscRing<T>& ring(std::size_t i) noexcept { return *rings_[i]; }
+
+        template <class... Args>
+        std::size_t push(Args&&... args)
+        {
+            if (!rings_[next_]->try_emplace(std::forward<Args>(args)...)) return rings_.size();
+            std::size_t used = next_;
+            next_ = next_ + 1 == rings_.size() ? 0 : next_ + 1;
+            return used;
+        }
+
+    private:
+        std::vector<std::unique_ptr<SpscRing<T>>> rings_;
+        std::size_t next_{ 0 };
+    };
+
+} // namespace SPSC
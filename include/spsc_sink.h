@@ -0,0 +1,425 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <stop_token>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #define SPSC_HAS_IO_URING 1
+#else
+    #define SPSC_HAS_IO_URING 0
+#endif
+
+#include "spsc_ring.h"
+#include "spsc_wait.h"
+
+namespace SPSC {
+
+    namespace Detail {
+
+        [[noreturn]] inline void throwErrno(int err, const char* what)
+        {
+            throw std::system_error(err, std::system_category(), what);
+        }
+
+        /**
+         * @Uring:     minimal io_uring for positional writes (raw syscalls, no liburing)
+         * - ok() is false when the kernel or a seccomp filter refuses io_uring_setup;
+         *   callers fall back to pwrite()
+         * - single submitter/reaper thread; ring indices use acquire/release via atomic_ref
+         */
+        class Uring final
+        {
+        public:
+            explicit Uring(unsigned entries) noexcept
+            {
+                #if SPSC_HAS_IO_URING
+                    if (!entries) return;
+                    io_uring_params p{};
+                    const int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+                    if (fd < 0) return;
+
+                    sq_bytes_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+                    cq_bytes_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+                    single_ = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                    if (single_) sq_bytes_ = cq_bytes_ = std::max(sq_bytes_, cq_bytes_);
+                    sqe_bytes_ = p.sq_entries * sizeof(io_uring_sqe);
+
+                    void* sq = ::mmap(nullptr, sq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+                    void* cq = single_ ? sq : ::mmap(nullptr, cq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+                    void* sqes = ::mmap(nullptr, sqe_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+                    if (sq == MAP_FAILED || cq == MAP_FAILED || sqes == MAP_FAILED) {
+                        if (sqes != MAP_FAILED) ::munmap(sqes, sqe_bytes_);
+                        if (!single_ && cq != MAP_FAILED) ::munmap(cq, cq_bytes_);
+                        if (sq != MAP_FAILED) ::munmap(sq, sq_bytes_);
+                        ::close(fd);
+                        return;
+                    }
+
+                    auto* sqb = static_cast<std::byte*>(sq);
+                    auto* cqb = static_cast<std::byte*>(cq);
+                    sq_ = sq; cq_ = cq;
+                    sq_head_ = reinterpret_cast<unsigned*>(sqb + p.sq_off.head);
+                    sq_tail_ = reinterpret_cast<unsigned*>(sqb + p.sq_off.tail);
+                    sq_mask_ = *reinterpret_cast<unsigned*>(sqb + p.sq_off.ring_mask);
+                    sq_array_ = reinterpret_cast<unsigned*>(sqb + p.sq_off.array);
+                    sq_entries_ = p.sq_entries;
+                    cq_head_ = reinterpret_cast<unsigned*>(cqb + p.cq_off.head);
+                    cq_tail_ = reinterpret_cast<unsigned*>(cqb + p.cq_off.tail);
+                    cq_mask_ = *reinterpret_cast<unsigned*>(cqb + p.cq_off.ring_mask);
+                    cqes_ = reinterpret_cast<io_uring_cqe*>(cqb + p.cq_off.cqes);
+                    sqes_ = static_cast<io_uring_sqe*>(sqes);
+                    fd_ = fd;
+                #else
+                    (void)entries;
+                #endif
+            }
+
+            ~Uring()
+            {
+                #if SPSC_HAS_IO_URING
+                    if (fd_ < 0) return;
+                    ::munmap(sqes_, sqe_bytes_);
+                    if (!single_) ::munmap(cq_, cq_bytes_);
+                    ::munmap(sq_, sq_bytes_);
+                    ::close(fd_);
+                #endif
+            }
+
+            Uring(const Uring&) = delete;
+            Uring& operator=(const Uring&) = delete;
+
+            bool ok() const noexcept { return fd_ >= 0; }
+
+            // SQEs published to the ring that the kernel has not taken yet (0 between calls)
+            unsigned pending() const noexcept
+            {
+                #if SPSC_HAS_IO_URING
+                    if (fd_ < 0) return 0;
+                    return std::atomic_ref<unsigned>(*sq_tail_).load(std::memory_order_relaxed) -
+                        std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+                #else
+                    return 0;
+                #endif
+            }
+
+            // Submit pwrite(fd, buf, len, off); the completion carries tag.
+            // true = the kernel owns the SQE (completion will come); false = nothing left queued
+            bool write(int fd, const void* buf, unsigned len, std::uint64_t off, std::uint64_t tag) noexcept
+            {
+                #if SPSC_HAS_IO_URING
+                    const unsigned tail = *sq_tail_;
+                    if (tail - std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire) == sq_entries_) return false;
+                    const unsigned idx = tail & sq_mask_;
+                    io_uring_sqe& e = sqes_[idx];
+                    std::memset(&e, 0, sizeof(e));
+                    e.opcode = IORING_OP_WRITE;
+                    e.fd = fd;
+                    e.addr = reinterpret_cast<std::uint64_t>(buf);
+                    e.len = len;
+                    e.off = off;
+                    e.user_data = tag;
+                    sq_array_[idx] = idx;
+                    std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+                    long r;
+                    do r = ::syscall(__NR_io_uring_enter, fd_, 1u, 0u, 0u, nullptr, 0ul);
+                    while (r < 0 && errno == EINTR);
+                    if (r == 1) return true;
+                    // Short or failed enter: without SQPOLL the kernel reads SQEs only inside enter, so
+                    // sq_head tells whether it took this one. Taken = submitted, its CQE is reaped by
+                    // wait(); not taken = withdraw it so the caller can reuse buf
+                    if (std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire) != tail) return true;
+                    std::atomic_ref<unsigned>(*sq_tail_).store(tail, std::memory_order_release);
+                    return false;
+                #else
+                    (void)fd; (void)buf; (void)len; (void)off; (void)tag;
+                    return false;
+                #endif
+            }
+
+            // Block for one completion; returns its result (bytes or -errno) and sets tag
+            int wait(std::uint64_t& tag) noexcept
+            {
+                #if SPSC_HAS_IO_URING
+                    for (;;) {
+                        const unsigned head = *cq_head_;
+                        if (head != std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire)) {
+                            const io_uring_cqe& c = cqes_[head & cq_mask_];
+                            tag = c.user_data;
+                            const int res = c.res;
+                            std::atomic_ref<unsigned>(*cq_head_).store(head + 1, std::memory_order_release);
+                            return res;
+                        }
+                        if (::syscall(__NR_io_uring_enter, fd_, 0u, 1u, IORING_ENTER_GETEVENTS, nullptr, 0ul) < 0 && errno != EINTR)
+                            return -errno;
+                    }
+                #else
+                    (void)tag;
+                    return -ENOSYS;
+                #endif
+            }
+
+        private:
+            int fd_{ -1 };
+            #if SPSC_HAS_IO_URING
+                void* sq_{ nullptr };
+                void* cq_{ nullptr };
+                std::size_t sq_bytes_{ 0 }, cq_bytes_{ 0 }, sqe_bytes_{ 0 };
+                bool single_{ false };
+                unsigned* sq_head_{ nullptr };
+                unsigned* sq_tail_{ nullptr };
+                unsigned* sq_array_{ nullptr };
+                unsigned sq_mask_{ 0 }, sq_entries_{ 0 };
+                unsigned* cq_head_{ nullptr };
+                unsigned* cq_tail_{ nullptr };
+                unsigned cq_mask_{ 0 };
+                io_uring_cqe* cqes_{ nullptr };
+                io_uring_sqe* sqes_{ nullptr };
+            #endif
+        };
+
+    } // namespace Detail
+
+    enum class SinkMode : std::uint8_t
+    {
+        Writev,     // readable spans -> iovecs -> writev(), no copy
+        Direct      // aligned double-buffered blocks at explicit offsets (for O_DIRECT fds)
+    };
+
+    /**
+     * @FileSink:      consumer stage persisting the raw bytes of a ring of trivially copyable T
+     * @writev:        read_spans() gives head..end and 0..tail; both go out in one writev(),
+     *                 then consume() releases them with one store
+     * @direct:
+     * - records are packed into one of two block_bytes buffers (4 KiB aligned); a full block is
+     *   submitted through io_uring while the other buffer fills, or pwrite()n when io_uring is off
+     *   or unavailable
+     * - flush() writes the partial block padded to 4 KiB and truncates the file to its logical size;
+     *   the block is rewritten in place once it fills
+     * - starts at the file's current end, which must be 4 KiB aligned
+     * @group_commit:  one fdatasync covers every record drained since the last one; it runs once
+     *                 sync_bytes are pending or sync_interval has passed, and durable() then
+     *                 tells producers how many records survive a crash
+     * @errors:        write/fsync failures throw std::system_error on the sink thread
+     * @threads:       drain/flush/sync/run on the ring's consumer thread; durable() from anywhere
+     */
+    template <class T>
+        requires std::is_trivially_copyable_v<T>
+    class FileSink final
+    {
+    public:
+        static constexpr std::size_t kAlign = 4096;
+
+        struct Options final
+        {
+            SinkMode mode{ SinkMode::Writev };
+            std::size_t block_bytes{ 1 << 20 };                 // Direct: bytes per write
+            bool io_uring{ true };                              // Direct: async submission when available
+            std::size_t sync_bytes{ 0 };                        // 0 = no size trigger
+            std::chrono::microseconds sync_interval{ 0 };       // 0 = no time trigger
+        };
+
+        explicit FileSink(int fd, Options opt = {})
+            : fd_(fd), opt_(opt), uring_(opt_.mode == SinkMode::Direct && opt_.io_uring ? 4 : 0)
+        {
+            if (opt_.mode != SinkMode::Direct) return;
+
+            block_ = std::max(kAlign, (opt_.block_bytes + kAlign - 1) & ~(kAlign - 1));
+            const off_t end = ::lseek(fd_, 0, SEEK_END);
+            if (end < 0) Detail::throwErrno(errno, "FileSink: lseek");
+            if (static_cast<std::size_t>(end) & (kAlign - 1)) throw std::invalid_argument("FileSink: file end not block aligned");
+            offset_ = static_cast<std::uint64_t>(end);
+            for (auto& b : buf_) b = static_cast<std::byte*>(::operator new(block_, std::align_val_t{ kAlign }));
+        }
+
+        ~FileSink()
+        {
+            try { flush(); } catch (...) {}
+            for (auto* b : buf_) if (b) ::operator delete(b, std::align_val_t{ kAlign });
+        }
+
+        FileSink(const FileSink&) = delete;
+        FileSink& operator=(const FileSink&) = delete;
+
+        bool uses_io_uring() const noexcept { return uring_.ok(); }
+        std::uint64_t records() const noexcept { return records_; }
+        std::uint64_t bytes() const noexcept { return bytes_; }
+        std::uint64_t syncs() const noexcept { return syncs_; }
+        std::uint64_t durable() const noexcept { return durable_.load(std::memory_order_acquire); }
+
+        // Sink Thread: persist everything readable in ring; returns records taken
+        std::size_t drain(SpscRing<T>& ring)
+        {
+            auto spans = ring.read_spans();
+            const std::size_t n = spans.size();
+            if (n) {
+                if (opt_.mode == SinkMode::Writev) {
+                    iovec iov[2] = {
+                        { spans.first.data(), spans.first.size_bytes() },
+                        { spans.second.data(), spans.second.size_bytes() }
+                    };
+                    writeAll(iov, spans.second.empty() ? 1 : 2);
+                } else {
+                    append(reinterpret_cast<const std::byte*>(spans.first.data()), spans.first.size_bytes());
+                    append(reinterpret_cast<const std::byte*>(spans.second.data()), spans.second.size_bytes());
+                }
+                ring.consume(n);
+                if (!unsynced_) since_ = std::chrono::steady_clock::now();
+                records_ += n;
+                bytes_ += n * sizeof(T);
+                unsynced_ += n * sizeof(T);
+            }
+            if (unsynced_ && syncDue()) sync();
+            return n;
+        }
+
+        // Sink Thread: get every drained byte to the file (Direct: partial block + in-flight writes)
+        void flush()
+        {
+            if (opt_.mode != SinkMode::Direct || !dirty_) return;
+            if (fill_) {
+                const std::size_t padded = (fill_ + kAlign - 1) & ~(kAlign - 1);
+                std::memset(buf_[cur_] + fill_, 0, padded - fill_);
+                submit(cur_, padded);
+            }
+            settle(0);
+            settle(1);
+            if (fill_ && ::ftruncate(fd_, static_cast<off_t>(offset_ + fill_)) != 0) Detail::throwErrno(errno, "FileSink: ftruncate");
+            dirty_ = false;
+        }
+
+        // Sink Thread: flush, then one fdatasync for everything drained so far
+        void sync()
+        {
+            flush();
+            if (::fdatasync(fd_) != 0) Detail::throwErrno(errno, "FileSink: fdatasync");
+            unsynced_ = 0;
+            ++syncs_;
+            durable_.store(records_, std::memory_order_release);
+        }
+
+        // Sink Thread: drain until stopped, flushing whenever a pass finds nothing; syncs on exit
+        template <class Wait = Wait::Backoff>
+        void run(SpscRing<T>& ring, std::stop_token st)
+        {
+            Wait wait{};
+            while (!st.stop_requested()) {
+                if (drain(ring)) { wait.reset(); continue; }
+                flush();
+                wait.wait();
+            }
+            drain(ring);
+            sync();
+        }
+
+    private:
+        bool syncDue() const noexcept
+        {
+            if (opt_.sync_bytes && unsynced_ >= opt_.sync_bytes) return true;
+            return opt_.sync_interval.count() && std::chrono::steady_clock::now() - since_ >= opt_.sync_interval;
+        }
+
+        void writeAll(iovec* iov, int cnt)
+        {
+            while (cnt) {
+                const ssize_t w = ::writev(fd_, iov, cnt);
+                if (w < 0) {
+                    if (errno == EINTR) continue;
+                    Detail::throwErrno(errno, "FileSink: writev");
+                }
+                // Partial write: skip whole iovecs, then trim the first remaining one
+                auto left = static_cast<std::size_t>(w);
+                while (cnt && left >= iov->iov_len) { left -= iov->iov_len; ++iov; --cnt; }
+                if (cnt) {
+                    iov->iov_base = static_cast<std::byte*>(iov->iov_base) + left;
+                    iov->iov_len -= left;
+                }
+            }
+        }
+
+        void append(const std::byte* p, std::size_t len)
+        {
+            if (len) dirty_ = true;
+            while (len) {
+                const std::size_t k = std::min(len, block_ - fill_);
+                std::memcpy(buf_[cur_] + fill_, p, k);
+                fill_ += k;
+                p += k;
+                len -= k;
+                if (fill_ == block_) {
+                    submit(cur_, block_);
+                    offset_ += block_;
+                    fill_ = 0;
+                    cur_ ^= 1;
+                    settle(cur_);   // the other buffer's write must land before it is refilled
+                }
+            }
+        }
+
+        // Write buffer b ([0, len)) at offset_; asynchronous when io_uring is up
+        void submit(unsigned b, std::size_t len)
+        {
+            settle(b);
+            if (uring_.ok() && uring_.write(fd_, buf_[b], static_cast<unsigned>(len), offset_, b)) {
+                inflight_[b] = len;
+                return;
+            }
+            for (std::size_t done = 0; done < len;) {
+                const ssize_t w = ::pwrite(fd_, buf_[b] + done, len - done, static_cast<off_t>(offset_ + done));
+                if (w < 0) {
+                    if (errno == EINTR) continue;
+                    Detail::throwErrno(errno, "FileSink: pwrite");
+                }
+                done += static_cast<std::size_t>(w);
+            }
+        }
+
+        // Reap completions until buffer b has none outstanding
+        void settle(unsigned b)
+        {
+            while (inflight_[b]) {
+                std::uint64_t tag = 0;
+                const int res = uring_.wait(tag);
+                if (res < 0) Detail::throwErrno(-res, "FileSink: io_uring write");
+                if (static_cast<std::size_t>(res) != inflight_[tag]) Detail::throwErrno(EIO, "FileSink: short io_uring write");
+                inflight_[tag] = 0;
+            }
+        }
+
+        int fd_;
+        Options opt_;
+        Detail::Uring uring_;
+
+        // Direct mode
+        std::size_t block_{ 0 };
+        std::byte* buf_[2]{ nullptr, nullptr };
+        std::size_t inflight_[2]{ 0, 0 };       // bytes submitted and not yet reaped, per buffer
+        unsigned cur_{ 0 };
+        std::size_t fill_{ 0 };
+        std::uint64_t offset_{ 0 };             // file offset of the current block
+        bool dirty_{ false };
+
+        std::uint64_t records_{ 0 };
+        std::uint64_t bytes_{ 0 };
+        std::uint64_t syncs_{ 0 };
+        std::uint64_t unsynced_{ 0 };
+        std::chrono::steady_clock::time_point since_{};
+        std::atomic<std::uint64_t> durable_{ 0 };
+    };
+
+} // namespace SPSC
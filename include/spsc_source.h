@@ -0,0 +1,200 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "spsc_ring.h"
+#include "spsc_wait.h"
+
+namespace SPSC {
+
+    // Zero-copy record: points into a MappedFile, valid while that file stays mapped
+    struct RecordView final
+    {
+        const std::byte* data{ nullptr };
+        std::size_t size{ 0 };
+        std::uint64_t offset{ 0 };     // file offset of data[0]
+    };
+
+    /**
+     * @MappedFile:    read-only MAP_PRIVATE mapping of a whole file
+     * - an empty file maps nothing (data() == nullptr, size() == 0)
+     * - advise() forwards madvise hints, page-rounded; failures are ignored (hints only)
+     */
+    class MappedFile final
+    {
+    public:
+        explicit MappedFile(const char* path)
+        {
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) throw std::system_error(errno, std::system_category(), "MappedFile: open");
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) {
+                const int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::system_category(), "MappedFile: fstat");
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_) {
+                void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    const int err = errno;
+                    ::close(fd);
+                    throw std::system_error(err, std::system_category(), "MappedFile: mmap");
+                }
+                data_ = static_cast<const std::byte*>(p);
+            }
+            ::close(fd);    // the mapping keeps the file referenced
+        }
+
+        ~MappedFile() { if (data_) ::munmap(const_cast<std::byte*>(data_), size_); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const std::byte* data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+
+        void advise(std::size_t offset, std::size_t len, int advice) const noexcept
+        {
+            if (!data_ || offset >= size_) return;
+            static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t begin = offset & ~(page - 1);
+            const std::size_t end = std::min(size_, offset + len);
+            ::madvise(const_cast<std::byte*>(data_) + begin, end - begin, advice);
+        }
+
+    private:
+        const std::byte* data_{ nullptr };
+        std::size_t size_{ 0 };
+    };
+
+    /**
+     * @Frame:         one framing decision, offsets relative to the bytes handed to the framer
+     * - the record is [begin, end); the next record starts at next
+     * - next == 0: no complete record in what is left (truncated tail)
+     */
+    struct Frame final
+    {
+        std::size_t begin{ 0 };
+        std::size_t end{ 0 };
+        std::size_t next{ 0 };
+    };
+
+    namespace Framing {
+
+        // '\n'-terminated records, terminator excluded; an unterminated last line still counts
+        struct Lines final
+        {
+            Frame operator()(const std::byte* p, std::size_t avail) const noexcept
+            {
+                const void* nl = std::memchr(p, '\n', avail);
+                if (!nl) return { 0, avail, avail };
+                const auto len = static_cast<std::size_t>(static_cast<const std::byte*>(nl) - p);
+                return { 0, len, len + 1 };
+            }
+        };
+
+        // [Len][payload] with a native-endian unsigned Len header; the view is the payload only
+        template <class Len = std::uint32_t>
+        struct LengthPrefixed final
+        {
+            Frame operator()(const std::byte* p, std::size_t avail) const noexcept
+            {
+                if (avail < sizeof(Len)) return {};
+                Len len;
+                std::memcpy(&len, p, sizeof(Len));
+                const std::size_t end = sizeof(Len) + static_cast<std::size_t>(len);
+                if (end > avail) return {};
+                return { sizeof(Len), end, end };
+            }
+        };
+
+        // Fixed-size records
+        struct Fixed final
+        {
+            std::size_t size;
+
+            Frame operator()(const std::byte*, std::size_t avail) const noexcept
+            {
+                if (avail < size) return {};
+                return { 0, size, size };
+            }
+        };
+
+    } // namespace Framing
+
+    /**
+     * @MappedSource:  producer stage that frames a MappedFile and pushes RecordViews into a ring
+     * @zero_copy:     views point into the mapping; record bytes are only touched by the framer
+     * @read_ahead:
+     * - MADV_SEQUENTIAL over the whole file at construction
+     * - on entering window k the source issues MADV_WILLNEED for window k + 1; the consumer is
+     *   at most one ring of views behind the source, so keep window >> ring capacity x record size
+     * @threads:       pump/run on the ring's producer thread; the file must outlive every view
+     */
+    template <class Framer = Framing::Lines>
+    class MappedSource final
+    {
+    public:
+        explicit MappedSource(const MappedFile& file, Framer framer = {}, std::size_t window = std::size_t{ 4 } << 20)
+            : file_(file), framer_(std::move(framer)), window_(window ? window : 1)
+        {
+            file_.advise(0, file_.size(), MADV_SEQUENTIAL);
+            file_.advise(0, window_, MADV_WILLNEED);
+        }
+
+        // Producer Thread: stage up to max views and publish them once; returns views pushed
+        std::size_t pump(SpscRing<RecordView>& ring, std::size_t max = static_cast<std::size_t>(-1))
+        {
+            std::size_t n = 0;
+            while (n < max && !done_) {
+                const Frame f = framer_(file_.data() + pos_, file_.size() - pos_);
+                if (f.next == 0) { done_ = true; break; }
+                if (!ring.try_stage(RecordView{ file_.data() + pos_ + f.begin, f.end - f.begin, pos_ + f.begin })) break;
+                pos_ += f.next;
+                ++n;
+                if (pos_ >= file_.size()) done_ = true;
+                else if (pos_ / window_ != ahead_) {
+                    ahead_ = pos_ / window_;
+                    file_.advise((ahead_ + 1) * window_, window_, MADV_WILLNEED);
+                }
+            }
+            ring.publish();
+            return n;
+        }
+
+        // Producer Thread: pump until every record is in the ring
+        template <class Wait = Wait::Backoff>
+        void run(SpscRing<RecordView>& ring, std::size_t batch = 64)
+        {
+            Wait wait{};
+            while (!done_) {
+                if (pump(ring, batch)) wait.reset();
+                else wait.wait();
+            }
+        }
+
+        bool done() const noexcept { return done_; }
+        std::uint64_t position() const noexcept { return pos_; }
+        std::size_t trailing() const noexcept { return file_.size() - pos_; }    // unframed bytes left at the end
+
+    private:
+        const MappedFile& file_;
+        Framer framer_;
+        std::size_t window_;
+        std::size_t pos_{ 0 };
+        std::size_t ahead_{ 0 };        // window the source is in; window ahead_ + 1 has been advised
+        bool done_{ file_.size() == 0 };
+    };
+
+} // namespace SPSC
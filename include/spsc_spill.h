@@ -0,0 +1,185 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    /**
+     * @SpillRing:     SpscRing that overflows to an unlinked spill file instead of failing
+     * @producer:
+     * - push() never blocks and never drops: while the ring has room it is a plain try_push
+     *   behind one predictable branch on a producer-private flag
+     * - the first failed push switches to spill mode; from then on every record is appended to
+     *   the file (buffered, buffer_bytes per write) so nothing overtakes what is already spilled
+     * - once the consumer has read everything spilled, the next push truncates the file and
+     *   goes back to the ring
+     * @consumer:
+     * - try_pop() takes the ring first: while spilling the ring only holds records older than the
+     *   spill, and after the switch back the spill is empty; then reads the file in order
+     * - the ring path costs the same as SpscRing::try_pop; the spill index is checked only when
+     *   the ring is empty
+     * @visibility:    buffered spill records reach the consumer on flush(), when the buffer fills,
+     *                 or on a push that finds the consumer caught up
+     * @errors:        I/O failures throw std::system_error
+     */
+    template <class T>
+        requires std::is_trivially_copyable_v<T>
+    class SpillRing final
+    {
+    public:
+        struct Options final
+        {
+            std::string dir{ "/tmp" };              // tmpfs or a local disk
+            std::size_t buffer_bytes{ 64 * 1024 };   // per write() on the producer, per read() on the consumer
+        };
+
+        explicit SpillRing(std::size_t cap, Options opt = {})
+            : ring_(cap), opt_(std::move(opt)),
+              per_io_(std::max<std::size_t>(1, opt_.buffer_bytes / sizeof(T)))
+        {
+            #ifdef O_TMPFILE
+                fd_ = ::open(opt_.dir.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+            #endif
+            if (fd_ < 0) {
+                std::string path = opt_.dir + "/spsc_spill.XXXXXX";
+                fd_ = ::mkstemp(path.data());
+                if (fd_ < 0) throw std::system_error(errno, std::system_category(), "SpillRing: spill file");
+                ::unlink(path.c_str());
+            }
+            out_.reserve(per_io_);
+            in_.resize(per_io_);
+        }
+
+        ~SpillRing() { ::close(fd_); }
+
+        SpillRing(const SpillRing&) = delete;
+        SpillRing& operator=(const SpillRing&) = delete;
+
+        std::size_t capacity() const noexcept { return ring_.capacity(); }
+        bool spilling() const noexcept { return spilling_; }                                        // producer view
+        std::uint64_t spilled() const noexcept { return spilled_; }                                 // producer: records ever spilled
+        std::uint64_t backlog() const noexcept                                                      // consumer: unread spilled records
+        {
+            // read_ moves a whole chunk at a time; subtract what this chunk already handed out
+            return written_.load(std::memory_order_acquire) - read_.load(std::memory_order_relaxed) - (in_pos_ < in_end_ ? in_pos_ : 0);
+        }
+
+        // Producer Thread
+        void push(const T& v)
+        {
+            if (!spilling_ && ring_.try_push(v)) [[likely]] return;
+            pushSlow(v);
+        }
+
+        // Producer Thread: make buffered spill records visible to the consumer
+        void flush()
+        {
+            if (out_.empty()) return;
+            const std::uint64_t written = written_.load(std::memory_order_relaxed);
+            const off_t off = static_cast<off_t>((written - base_.load(std::memory_order_relaxed)) * sizeof(T));
+            const auto* p = reinterpret_cast<const std::byte*>(out_.data());
+            for (std::size_t done = 0, len = out_.size() * sizeof(T); done < len;) {
+                const ssize_t w = ::pwrite(fd_, p + done, len - done, off + static_cast<off_t>(done));
+                if (w < 0) {
+                    if (errno == EINTR) continue;
+                    throwErrno("SpillRing: pwrite");
+                }
+                done += static_cast<std::size_t>(w);
+            }
+            written_.store(written + out_.size(), std::memory_order_release);
+            out_.clear();
+        }
+
+        // Consumer Thread
+        bool try_pop(T& out)
+        {
+            if (ring_.try_pop(out)) [[likely]] return true;
+            return popSpill(out);
+        }
+
+    private:
+        [[noreturn]] static void throwErrno(const char* what)
+        {
+            throw std::system_error(errno, std::system_category(), what);
+        }
+
+        // Producer: ring full, or already spilling
+        void pushSlow(const T& v)
+        {
+            if (!spilling_) {
+                spilling_ = true;
+            } else if (out_.empty() && read_.load(std::memory_order_acquire) == written_.load(std::memory_order_relaxed)) {
+                // Backlog cleared: the consumer has read every spilled record and the ring is empty
+                if (::ftruncate(fd_, 0) != 0) throwErrno("SpillRing: ftruncate");
+                base_.store(written_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                spilling_ = false;
+                if (ring_.try_push(v)) return;
+                spilling_ = true;
+            }
+            out_.push_back(v);
+            ++spilled_;
+            // Flush when full, or right away if the consumer is idle waiting on the spill
+            if (out_.size() == per_io_ || read_.load(std::memory_order_acquire) == written_.load(std::memory_order_relaxed)) flush();
+        }
+
+        // Consumer: ring empty; hand out the next spilled record if there is one
+        bool popSpill(T& out)
+        {
+            if (in_pos_ == in_end_) {
+                const std::uint64_t read = read_.load(std::memory_order_relaxed);
+                const std::uint64_t avail = written_.load(std::memory_order_acquire) - read;
+                if (!avail) return false;
+                const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(avail, per_io_));
+                const off_t off = static_cast<off_t>((read - base_.load(std::memory_order_relaxed)) * sizeof(T));
+                auto* p = reinterpret_cast<std::byte*>(in_.data());
+                for (std::size_t done = 0, len = n * sizeof(T); done < len;) {
+                    const ssize_t r = ::pread(fd_, p + done, len - done, off + static_cast<off_t>(done));
+                    if (r < 0 && errno == EINTR) continue;
+                    if (r <= 0) throwErrno("SpillRing: pread");
+                    done += static_cast<std::size_t>(r);
+                }
+                in_pos_ = 0;
+                in_end_ = n;
+            }
+            out = in_[in_pos_++];
+            // Release the chunk only once it is fully handed out; the producer may truncate after that
+            if (in_pos_ == in_end_) read_.store(read_.load(std::memory_order_relaxed) + in_end_, std::memory_order_release);
+            return true;
+        }
+
+        SpscRing<T> ring_;
+        Options opt_;
+        std::size_t per_io_;
+        int fd_{ -1 };
+
+        // producer-private
+        bool spilling_{ false };
+        std::uint64_t spilled_{ 0 };
+        std::vector<T> out_;
+
+        // shared: spill indices (records), file offset = (index - base_) * sizeof(T)
+        alignas(64) std::atomic<std::uint64_t> written_{ 0 };
+        alignas(64) std::atomic<std::uint64_t> read_{ 0 };
+        std::atomic<std::uint64_t> base_{ 0 };      // written by the producer only while read_ == written_
+
+        // consumer-private
+        alignas(64) std::vector<T> in_;
+        std::size_t in_pos_{ 0 };
+        std::size_t in_end_{ 0 };
+    };
+
+} // namespace SPSC
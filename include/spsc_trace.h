@@ -0,0 +1,169 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>  // __rdtsc
+#endif
+
+#include "spsc_ring.h"
+
+namespace SPSC {
+
+    // Cycle counter on x86 (invariant TSC assumed), steady_clock ns elsewhere
+    inline std::uint64_t readTsc() noexcept
+    {
+        #if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+        #else
+            return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif
+    }
+
+    /**
+     * @TraceContext:  per-message hop stamps carried inside the slot
+     * - stamps[2h]: pushed into ring h,  stamps[2h+1]: popped from ring h
+     * - unsampled messages carry the array but never touch it (one predictable branch per hop)
+     */
+    template <std::size_t Hops>
+    struct TraceContext final
+    {
+        std::array<std::uint64_t, 2 * Hops> stamps{};
+        std::uint8_t hop{ 0 };
+        bool sampled{ false };
+
+        void on_push() noexcept { if (sampled && hop < Hops) stamps[2 * hop] = readTsc(); }
+        void on_pop() noexcept
+        {
+            if (!sampled || hop >= Hops) return;
+            stamps[2 * hop + 1] = readTsc();
+            ++hop;
+        }
+    };
+
+    template <class T, std::size_t Hops>
+    struct Traced final
+    {
+        T value;
+        TraceContext<Hops> trace;
+    };
+
+    // 1 in N (N rounded up to a power of two so the test is a mask); N == 0 disables
+    class TraceSampler final
+    {
+    public:
+        explicit TraceSampler(std::uint64_t every)
+            : mask_(every ? BitOps::ceilPow2(every) - 1 : 0), on_(every != 0) {}
+
+        bool next() noexcept { return on_ && (count_++ & mask_) == 0; }
+
+    private:
+        std::uint64_t mask_;
+        std::uint64_t count_{ 0 };
+        bool on_;
+    };
+
+    /**
+     * @TracedRing:    SpscRing<Traced<T, Hops>> that stamps the context on push and pop
+     * - the push stamp is written before the release store, so the consumer sees it
+     */
+    template <class T, std::size_t Hops>
+    class TracedRing final
+    {
+    public:
+        using value_type = Traced<T, Hops>;
+
+        explicit TracedRing(std::size_t cap) : ring_(cap) {}
+
+        bool try_push(value_type&& v) noexcept(noexcept(value_type(std::move(v))))
+        {
+            v.trace.on_push();
+            return ring_.try_push(std::move(v));
+        }
+
+        bool try_pop(value_type& out) noexcept
+        {
+            if (!ring_.try_pop(out)) return false;
+            out.trace.on_pop();
+            return true;
+        }
+
+        SpscRing<value_type>& ring() noexcept { return ring_; }
+
+    private:
+        SpscRing<value_type> ring_;
+    };
+
+    /**
+     * @LatencyHistogram:  log2-bucketed (BitOps::floorLog2u64) cycle histogram; fixed size, no allocation
+     */
+    class LatencyHistogram final
+    {
+    public:
+        void add(std::uint64_t v) noexcept
+        {
+            int b = BitOps::floorLog2u64(v) + 1;    // bucket 0 holds v == 0
+            ++buckets_[static_cast<std::size_t>(b)];
+            ++count_;
+            sum_ += v;
+            if (v > max_) max_ = v;
+        }
+
+        std::uint64_t count() const noexcept { return count_; }
+        std::uint64_t max() const noexcept { return max_; }
+        double mean() const noexcept { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+        // Upper bound of the bucket holding quantile q (0..1)
+        std::uint64_t quantile(double q) const noexcept
+        {
+            if (!count_) return 0;
+            auto rank = static_cast<std::uint64_t>(q * static_cast<double>(count_ - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t b = 0; b < buckets_.size(); ++b) {
+                seen += buckets_[b];
+                if (seen >= rank) return b == 0 ? 0 : (b >= 64 ? ~0ull : (1ull << b) - 1);
+            }
+            return max_;
+        }
+
+    private:
+        std::array<std::uint64_t, 65> buckets_{};
+        std::uint64_t count_{ 0 };
+        std::uint64_t sum_{ 0 };
+        std::uint64_t max_{ 0 };
+    };
+
+    /**
+     * @TraceCollector:    per-hop queueing and per-stage processing histograms
+     * - queueing(h):   pop from ring h - push into ring h
+     * - processing(h): push into ring h+1 - pop from ring h (the stage between the two rings)
+     * @threads:          record() from the thread that consumes the last ring only
+     */
+    template <std::size_t Hops>
+    class TraceCollector final
+    {
+    public:
+        void record(const TraceContext<Hops>& t) noexcept
+        {
+            if (!t.sampled) return;
+            for (std::size_t h = 0; h < t.hop; ++h) {
+                queue_[h].add(t.stamps[2 * h + 1] - t.stamps[2 * h]);
+                if (h + 1 < t.hop) proc_[h].add(t.stamps[2 * h + 2] - t.stamps[2 * h + 1]);
+            }
+            if (t.hop) total_.add(t.stamps[2 * t.hop - 1] - t.stamps[0]);
+        }
+
+        const LatencyHistogram& queueing(std::size_t hop) const noexcept { return queue_[hop]; }
+        const LatencyHistogram& processing(std::size_t hop) const noexcept { return proc_[hop]; }
+        const LatencyHistogram& end_to_end() const noexcept { return total_; }
+
+    private:
+        std::array<LatencyHistogram, Hops> queue_{};
+        std::array<LatencyHistogram, Hops> proc_{};
+        LatencyHistogram total_{};
+    };
+
+} // namespace SPSC
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>  // _mm_pause
+#endif
+
+namespace SPSC {
+
+    /**
+     * @wait_strategies:   what a polling thread does when its ring has nothing for it
+     * @interface:
+     * - wait():  called once per empty (or full) poll
+     * - reset(): called after progress, so escalating strategies start over
+     */
+    namespace Wait {
+
+        inline void cpuRelax() noexcept
+        {
+            #if defined(__x86_64__) || defined(__i386__)
+                _mm_pause();
+            #elif defined(__aarch64__)
+                asm volatile("yield" ::: "memory");
+            #else
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+            #endif
+        }
+
+        // Burn the core; lowest latency, owns the CPU
+        struct BusySpin final
+        {
+            void wait() noexcept {}
+            void reset() noexcept {}
+        };
+
+        // Spin with a pause hint; frees pipeline resources for an SMT sibling
+        struct SpinPause final
+        {
+            void wait() noexcept { cpuRelax(); }
+            void reset() noexcept {}
+        };
+
+        // Give the core back to the scheduler on every empty poll
+        struct Yield final
+        {
+            void wait() noexcept { std::this_thread::yield(); }
+            void reset() noexcept {}
+        };
+
+        // Pause for a while, then yield, then sleep; for stages that can go idle for long stretches
+        struct Backoff final
+        {
+            std::uint32_t spins{ 0 };
+
+            void wait() noexcept
+            {
+                if (spins < 64) cpuRelax();
+                else if (spins < 128) std::this_thread::yield();
+                else std::this_thread::sleep_for(std::chrono::microseconds(50));
+                if (spins < 128) ++spins;
+            }
+            void reset() noexcept { spins = 0; }
+        };
+
+    } // namespace Wait
+
+} // namespace SPSC
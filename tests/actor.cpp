@@ -0,0 +1,113 @@
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "spsc_actor.h"
+
+struct Ping { std::uint64_t n; };
+struct Note { std::string text; };
+
+struct Ponger;
+
+struct Counter
+{
+    std::atomic<std::uint64_t> seen{ 0 };
+    void receive(Ping&) { seen.fetch_add(1, std::memory_order_relaxed); }
+};
+
+struct Pinger
+{
+    SPSC::ActorSystem* sys;
+    SPSC::ActorRef<Ponger>* peer;
+    std::atomic<std::uint64_t>* done;
+
+    void receive(Ping& p);
+};
+
+struct Ponger
+{
+    SPSC::ActorSystem* sys;
+    SPSC::ActorRef<Pinger>* peer;
+    std::uint64_t notes{ 0 };
+
+    void receive(Ping& p)
+    {
+        while (!sys->send<Ping>(*peer, Ping{ p.n + 1 })) std::this_thread::yield();
+    }
+    void receive(Note& n) { notes += n.text.size(); }
+};
+
+void Pinger::receive(Ping& p)
+{
+    if (p.n >= 10000) { done->store(p.n, std::memory_order_release); return; }
+    while (!sys->send<Ping>(*peer, Ping{ p.n + 1 })) std::this_thread::yield();
+}
+
+int main() {
+
+    // ------------------------ Doorbell: ring/take is an exact active set ---------------
+    SPSC::Doorbell bell(70);
+    assert(bell.words() == 2);
+    bell.ring(3);
+    bell.ring(65);
+    assert(bell.take(0) == (1ull << 3) && bell.take(0) == 0);
+    assert(bell.take(1) == (1ull << 1));
+
+    // ------------------------ Cross-core ping-pong through lazily created mailboxes ----
+    SPSC::ActorSystem::Options opt;
+    opt.cores = 2;
+    opt.mailbox_cap = 64;
+    SPSC::ActorSystem sys(opt);
+
+    std::atomic<std::uint64_t> done{ 0 };
+    SPSC::ActorRef<Ponger> pong_ref{};
+    SPSC::ActorRef<Pinger> ping_ref{};
+    ping_ref = sys.spawn<Pinger>(0, Pinger{ &sys, &pong_ref, &done });
+    pong_ref = sys.spawn<Ponger>(1, Ponger{ &sys, &ping_ref });
+    sys.start();
+
+    // ------------------------ External thread sends typed messages in place -----------
+    assert(sys.send<Note>(pong_ref, Note{ "hello" }));
+    assert(sys.send<Ping>(pong_ref, Ping{ 0 }));
+    while (done.load(std::memory_order_acquire) == 0) std::this_thread::yield();
+    sys.stop();
+
+    assert(done.load() == 10001);     // Pinger only ever sees odd counts
+    assert(pong_ref.actor->notes == 5);
+
+    // ------------------------ One thread, two systems: one endpoint in each -----------
+    {
+        SPSC::ActorSystem::Options o;
+        o.external = 1;
+        SPSC::ActorSystem a(o), b(o);
+        auto ca = a.spawn<Counter>(0);
+        auto cb = b.spawn<Counter>(0);
+        a.start();
+        b.start();
+        for (int i = 0; i < 1000; ++i) {           // used to claim a new endpoint on every switch
+            while (!a.send<Ping>(ca, Ping{ 0 })) std::this_thread::yield();
+            while (!b.send<Ping>(cb, Ping{ 0 })) std::this_thread::yield();
+        }
+        while (ca.actor->seen.load() != 1000 || cb.actor->seen.load() != 1000) std::this_thread::yield();
+    }
+
+    // ------------------------ A system rebuilt at the same address: no stale endpoint --
+    {
+        SPSC::ActorSystem::Options o;
+        o.external = 1;
+        std::optional<SPSC::ActorSystem> s;
+        s.emplace(o);
+        s->attach();                                // main is endpoint 1 of the first system
+        s.reset();
+        s.emplace(o);
+        std::thread([&] { s->attach(); }).join();   // another thread takes the only endpoint
+        bool threw = false;
+        try { s->attach(); } catch (const std::runtime_error&) { threw = true; }
+        assert(threw);                              // main must not believe it still owns endpoint 1
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "spsc_bus.h"
+
+int main() {
+
+    // ------------------------ Fan-out, per-subscriber policies ------------------------
+    {
+        SPSC::TopicBus<std::uint64_t> bus(2);
+        auto fast = bus.subscribe(0, SPSC::SlowPolicy::Drop, 64);
+        auto drop = bus.subscribe(0, SPSC::SlowPolicy::Drop, 4);
+        auto conf = bus.subscribe(0, SPSC::SlowPolicy::Conflate, 4);
+        auto other = bus.subscribe(1);
+        assert(bus.subscribers(0) == 3 && bus.subscribers(1) == 1);
+
+        for (std::uint64_t i = 0; i < 10; ++i) bus.publish(0, i);
+
+        std::uint64_t v = 0;
+        for (std::uint64_t i = 0; i < 10; ++i) { assert(fast.try_pop(v) && v == i); }
+        assert(!other.try_pop(v));
+
+        // a ring of 4 holds 3
+        for (std::uint64_t i = 0; i < 3; ++i) { assert(drop.try_pop(v) && v == i); }
+        assert(!drop.try_pop(v) && drop.dropped() == 7);
+
+        // 0..2 in the ring, 3..8 overwritten in the side slot, 9 parked
+        for (std::uint64_t i = 0; i < 3; ++i) { assert(conf.try_pop(v) && v == i); }
+        assert(!conf.try_pop(v) && conf.conflated() == 6);
+        bus.flush(0);
+        assert(conf.try_pop(v) && v == 9);
+        assert(!conf.try_pop(v));
+    }
+
+    // ------------------------ Unsubscribe, reclamation ------------------------
+    {
+        SPSC::TopicBus<int> bus(1);
+        auto a = bus.subscribe(0);
+        {
+            auto b = bus.subscribe(0);
+            assert(bus.subscribers(0) == 2);
+        }
+        assert(bus.subscribers(0) == 1);
+        assert(bus.retired() > 0);              // publisher has not seen the newest list yet
+        assert(bus.publish(0, 7) == 1);
+        assert(bus.reclaim() > 0 && bus.retired() == 0);
+
+        SPSC::TopicBus<int>::Subscription moved = std::move(a);
+        assert(!a && moved);
+        int v = 0;
+        assert(moved.try_pop(v) && v == 7);
+        moved.reset();
+        assert(bus.subscribers(0) == 0 && bus.publish(0, 8) == 0);
+
+        // Reset and moved-from subscriptions read as empty lanes
+        assert(!moved.try_pop(v) && !moved.front() && moved.dropped() == 0 && moved.conflated() == 0);
+        assert(!a.try_pop(v) && !a.front() && a.dropped() == 0);
+
+        // Idle publisher: the retired lane waits for flush(), which reports the current list
+        auto c = bus.subscribe(0);
+        c.reset();
+        assert(bus.reclaim() == 0 && bus.retired() > 0);
+        bus.flush(0);
+        assert(bus.reclaim() > 0 && bus.retired() == 0);
+    }
+
+    // ------------------------ Block: lossless, unblocked by unsubscribe ------------------------
+    {
+        SPSC::TopicBus<std::uint64_t, SPSC::Wait::Yield> bus(1);
+        auto sub = bus.subscribe(0, SPSC::SlowPolicy::Block, 8);
+        constexpr std::uint64_t N = 20000;
+
+        std::jthread pub([&] { for (std::uint64_t i = 0; i < N; ++i) bus.publish(0, i); });
+        std::uint64_t v = 0;
+        for (std::uint64_t i = 0; i < N; ++i) {
+            while (!sub.try_pop(v)) std::this_thread::yield();
+            assert(v == i);
+        }
+        pub.join();
+
+        for (std::uint64_t i = 0; i < 7; ++i) bus.publish(0, i);
+        std::jthread stuck([&] { bus.publish(0, 99); });    // lane full: waits
+        std::this_thread::yield();
+        sub.reset();
+        stuck.join();
+    }
+
+    // ------------------------ Churn while publishing ------------------------
+    {
+        SPSC::TopicBus<std::uint64_t> bus(1);
+        std::atomic<bool> stop{ false };
+        std::jthread pub([&] {
+            std::uint64_t i = 0;
+            while (!stop.load(std::memory_order_acquire)) { bus.publish(0, i++); std::this_thread::yield(); }
+        });
+
+        std::vector<std::jthread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                for (int round = 0; round < 50; ++round) {
+                    auto sub = bus.subscribe(0, SPSC::SlowPolicy::Drop, 16);
+                    std::uint64_t v = 0, last = 0;
+                    bool first = true;
+                    for (int k = 0; k < 20; ++k) {
+                        if (sub.try_pop(v)) { assert(first || v > last); last = v; first = false; }
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        readers.clear();
+        stop.store(true, std::memory_order_release);
+        pub.join();
+        bus.publish(0, 0);                      // publisher role moves here: report the final list
+        bus.reclaim();
+        assert(bus.subscribers(0) == 0 && bus.retired() == 0);
+    }
+
+    return 0;
+}
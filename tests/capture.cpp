@@ -0,0 +1,127 @@
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "spsc_capture.h"
+
+namespace {
+    struct Order
+    {
+        std::uint64_t id;
+        std::int32_t qty;
+        std::int32_t side;
+    };
+
+    std::string tempPath()
+    {
+        char path[] = "/tmp/spsc_capture_XXXXXX";
+        ::close(::mkstemp(path));
+        return path;
+    }
+}
+
+int main() {
+
+    const std::string path = tempPath();
+
+    // ------------------------ Record: burst, 20 ms gap, burst ------------------------
+    {
+        SPSC::SpscRing<Order> ring(64);
+        SPSC::CaptureRecorder<Order> rec(path.c_str(), { 256, true, 0 });
+        SPSC::CaptureTap<Order> tap(ring, rec);
+        Order o{};
+        for (std::uint64_t i = 0; i < 40; ++i) { assert(tap.try_push(Order{ i, 1, 0 })); assert(ring.try_pop(o)); }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (std::uint64_t i = 40; i < 80; ++i) { assert(tap.try_push(Order{ i, 2, 1 })); assert(ring.try_pop(o)); }
+
+        // A push the ring refuses is not recorded
+        for (std::uint64_t i = 0; i < 63; ++i) assert(ring.try_push(Order{}));
+        assert(!tap.try_push(Order{ 999, 0, 0 }));
+        assert(rec.lost() == 0);
+    }
+
+    // ------------------------ Read back ------------------------
+    SPSC::CaptureReplayer<Order> rep(path.c_str());
+    assert(rep.size() == 80 && rep.complete() && rep.lost() == 0);
+    for (std::size_t i = 1; i < rep.size(); ++i) assert(rep.at(i).ts >= rep.at(i - 1).ts);
+    assert(rep.at(40).ts - rep.at(39).ts >= 20'000'000);
+    assert(rep.duration_ns() >= 20'000'000);
+
+    // ------------------------ Replay: original pacing keeps the gap, fast mode drops it ----------
+    auto timed = [&](double speed) {
+        SPSC::SpscRing<Order> ring(128);
+        const auto t0 = std::chrono::steady_clock::now();
+        assert(rep.replay(ring, speed) == 80);
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+        Order o{};
+        for (std::uint64_t i = 0; i < 80; ++i) { assert(ring.try_pop(o)); assert(o.id == i && o.qty == (i < 40 ? 1 : 2)); }
+        return ns;
+    };
+    assert(timed(1.0) >= 20'000'000);
+    const auto fast4 = timed(4.0);
+    assert(fast4 >= 5'000'000);
+    assert(timed(0) < 5'000'000);
+
+    // Wrong element type is refused
+    bool threw = false;
+    try { SPSC::CaptureReplayer<std::uint64_t> bad(path.c_str()); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    ::unlink(path.c_str());
+
+    // ------------------------ Record padding is written as zeros ------------------------
+    {
+        const std::string padded = tempPath();
+        static_assert(sizeof(SPSC::CaptureRecord<std::uint32_t>) == 16);    // 4 bytes of tail padding
+        {
+            SPSC::CaptureRecorder<std::uint32_t> rec(padded.c_str(), { 64, true, 0 });
+            for (std::uint32_t i = 0; i < 32; ++i) rec.record(0xA5A5A5A5u ^ i, i);
+        }
+        SPSC::MappedFile f(padded.c_str());
+        assert(f.size() == sizeof(SPSC::CaptureHeader) + 32 * 16);
+        for (std::size_t i = 0; i < 32; ++i)
+            for (std::size_t b = 12; b < 16; ++b)
+                assert(f.data()[sizeof(SPSC::CaptureHeader) + i * 16 + b] == std::byte{ 0 });
+        ::unlink(padded.c_str());
+    }
+
+    // ------------------------ Blocking is the default; a lossy capture says so in its header ----------
+    {
+        static_assert(SPSC::CaptureRecorder<Order>::Options{}.block_when_full);
+        const std::string lossy = tempPath();
+        std::uint64_t dropped = 0;
+        {
+            SPSC::CaptureRecorder<Order> rec(lossy.c_str(), { 4, false, 0 });
+            for (std::uint64_t i = 0; i < 1000; ++i) rec.record(Order{ i, 0, 0 }, i);
+            dropped = rec.lost();
+        }
+        assert(dropped > 0);
+        {
+            SPSC::CaptureReplayer<Order> r(lossy.c_str());
+            assert(!r.complete() && r.lost() == dropped && r.size() + dropped == 1000);
+        }
+
+        // A recorder that never closed leaves the count unknown
+        const int fd = ::open(lossy.c_str(), O_WRONLY);
+        const std::uint64_t unknown = SPSC::CaptureHeader::kLostUnknown;
+        assert(::pwrite(fd, &unknown, sizeof(unknown), offsetof(SPSC::CaptureHeader, lost)) == sizeof(unknown));
+        ::close(fd);
+        SPSC::CaptureReplayer<Order> r(lossy.c_str());
+        assert(!r.complete() && r.lost() == SPSC::CaptureHeader::kLostUnknown);
+        ::unlink(lossy.c_str());
+    }
+
+    // ------------------------ A failed open throws ------------------------
+    {
+        bool failed = false;
+        try { SPSC::CaptureRecorder<Order> bad("/nonexistent-dir/capture.bin"); } catch (const std::system_error&) { failed = true; }
+        assert(failed);
+    }
+    return 0;
+}
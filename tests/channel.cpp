@@ -0,0 +1,94 @@
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "spsc_channel.h"
+
+// Roles are types: a Consumer cannot push, neither end can be copied
+static_assert(!std::is_copy_constructible_v<SPSC::Producer<int>>);
+static_assert(!std::is_copy_constructible_v<SPSC::Consumer<int>>);
+static_assert(std::is_nothrow_move_constructible_v<SPSC::Producer<int>>);
+static_assert(alignof(SPSC::Producer<int>) >= 64 && alignof(SPSC::Consumer<int>) >= 64);
+
+int main() {
+
+    // ------------------------ Basic FIFO, counters ------------------------
+    {
+        auto [tx, rx] = SPSC::makeChannel<int>(4);
+        assert(tx && rx && tx.capacity() == 4);
+        assert(tx.try_push(1) && tx.try_push(2) && tx.try_emplace(3));
+        assert(!tx.try_push(4) && tx.rejected() == 1 && tx.pushed() == 3);
+
+        int v = 0;
+        assert(rx.try_pop(v) && v == 1);
+        assert(*rx.front() == 2);
+        rx.pop_front();
+        assert(rx.try_pop(v) && v == 3);
+        assert(!rx.try_pop(v) && rx.popped() == 3 && rx.empty_polls() == 1);
+    }
+
+    // ------------------------ Staging, batch consume, in-place access ------------------------
+    {
+        auto [tx, rx] = SPSC::makeChannel<std::string>(8);
+        for (int i = 0; i < 5; ++i) assert(tx.try_stage(std::to_string(i)));
+        assert(tx.staged() == 5 && rx.available() == 0);
+        tx.publish();
+        assert(tx.staged() == 0 && rx.available() == 5);
+        assert(*rx.front_at(0) == "0" && *rx.front_at(4) == "4");
+        rx.consume(3);
+        assert(rx.popped() == 3 && *rx.front() == "3");
+
+        assert(tx.try_stage("dropped"));        // staged, never published: destroyed with the handle
+        {
+            auto gone = std::move(tx);
+            assert(!tx && gone.staged() == 1);
+        }
+        std::string s;
+        assert(rx.try_pop(s) && s == "3");
+        assert(rx.try_pop(s) && s == "4");
+        assert(!rx.try_pop(s));
+    }
+
+    // ------------------------ Core outlives either end, published elements destroyed once ------------------------
+    {
+        auto counter = std::make_shared<int>(0);
+        {
+            auto [tx, rx] = SPSC::makeChannel<std::shared_ptr<int>>(8);
+            for (int i = 0; i < 3; ++i) assert(tx.try_push(counter));
+            assert(counter.use_count() == 4);
+            { auto drop = std::move(rx); }      // consumer gone, core still held by tx
+            assert(counter.use_count() == 4);
+        }
+        assert(counter.use_count() == 1);
+    }
+
+    // ------------------------ Ends moved into their threads ------------------------
+    {
+        constexpr std::uint64_t N = 200000;
+        auto [tx, rx] = SPSC::makeChannel<std::uint64_t>(256);
+
+        std::jthread prod([p = std::move(tx)]() mutable {
+            for (std::uint64_t i = 0; i < N; ++i) {
+                while (!p.try_stage(i)) { p.publish(); std::this_thread::yield(); }
+                if ((i & 15) == 15) p.publish();
+            }
+            p.publish();
+        });
+        std::jthread cons([c = std::move(rx)]() mutable {
+            std::uint64_t expect = 0;
+            while (expect < N) {
+                const std::size_t n = c.available();
+                if (!n) { std::this_thread::yield(); continue; }
+                for (std::size_t i = 0; i < n; ++i) assert(*c.front_at(i) == expect + i);
+                c.consume(n);
+                expect += n;
+            }
+            assert(c.popped() == N);
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "spsc_duplex.h"
+
+struct Order { std::uint64_t qty; };
+struct Verdict { bool ok; std::uint64_t qty; };
+
+int main() {
+
+    SPSC::Duplex<Order, Verdict> risk(8);
+    assert(risk.max_outstanding() == 8);
+
+    // ------------------------ Pipelined calls, out-of-order takes ----------------------
+    std::vector<std::uint64_t> ids;
+    std::uint64_t id = 0;
+    while (risk.try_call(id, Order{ ids.size() * 10 })) ids.push_back(id);
+    assert(ids.size() == 7);                  // ring keeps one slot empty
+    assert(risk.serve([](Order& o) { return Verdict{ o.qty < 40, o.qty }; }) == 7);
+
+    Verdict v{};
+    assert(risk.try_take(ids[5], v) && v.qty == 50 && !v.ok);
+    assert(!risk.try_take(ids[5], v));        // already claimed
+    assert(risk.try_take(ids[0], v) && v.qty == 0 && v.ok);
+    assert(risk.outstanding() == 5);
+
+    // ------------------------ Untaken slot blocks its alias, not other ids -------------
+    assert(risk.try_call(id, Order{ 1 }));    // id 7 -> slot 7, free
+    assert(risk.try_call(id, Order{ 2 }));    // id 8 -> slot 0, freed above
+    assert(!risk.try_call(id, Order{ 3 }));   // id 9 -> slot 1 still holds id 1
+    for (std::size_t i = 1; i < 7; ++i) if (i != 5) assert(risk.try_take(ids[i], v));
+
+    // ------------------------ Synchronous calls against a server thread ----------------
+    SPSC::Duplex<Order, Verdict> rpc(64);
+    std::jthread server([&](std::stop_token st) {
+        while (!st.stop_requested())
+            if (!rpc.serve([](Order& o) { return Verdict{ true, o.qty * 2 }; })) std::this_thread::yield();
+    });
+    for (std::uint64_t i = 0; i < 2000; ++i) {
+        Verdict r = rpc.call<SPSC::Wait::Yield>(Order{ i });
+        assert(r.ok && r.qty == 2 * i);
+    }
+    return 0;
+}
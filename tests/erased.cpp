@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "spsc_erased.h"
+
+int main() {
+
+    // ------------------------ Size classes and geometry ------------------------
+    {
+        SPSC::ErasedRing a(8, 8, 8), b(8, 64, 64), c(8, 24, 8), d(8, 4, 8), e(8, 16, 8);
+        assert(a.fast_path() && b.fast_path() && e.fast_path());
+        assert(!c.fast_path() && !d.fast_path());
+        assert(c.stride() == 24 && d.stride() == 8 && b.stride() == 64);
+
+        bool threw = false;
+        try { SPSC::ErasedRing bad(8, 16, 3); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+    }
+
+    // ------------------------ Defaulted alignment, size-only classes, overflow ------------------------
+    {
+        SPSC::ErasedRing a(8, 8), b(8, 12), c(8, 64), d(8, 7), e(8, 8, 64);
+        assert(a.fast_path() && a.elem_align() == 8 && a.stride() == 8);       // not max_align_t's 16
+        assert(!b.fast_path() && b.elem_align() == 4 && b.stride() == 12);
+        assert(c.fast_path() && c.elem_align() == alignof(std::max_align_t) && c.stride() == 64);
+        assert(!d.fast_path() && d.elem_align() == 1 && d.stride() == 7);
+        assert(e.fast_path() && e.stride() == 64);                              // over-aligned: still an 8-byte copy
+
+        std::uint64_t in = 0x0123456789abcdefull, out = 0;
+        assert(e.try_push(&in) && e.try_pop(&out) && out == in);
+
+        const std::size_t huge = std::numeric_limits<std::size_t>::max();
+        int threw = 0;
+        try { SPSC::ErasedRing bad(huge / 64, 128); } catch (const std::length_error&) { ++threw; }     // cap * stride
+        try { SPSC::ErasedRing bad(8, huge - 2, 16); } catch (const std::length_error&) { ++threw; }   // size + align - 1
+        try { SPSC::ErasedRing bad(huge, 8); } catch (const std::length_error&) { ++threw; }           // cap rounds past 2^63
+        assert(threw == 3);
+    }
+
+    // ------------------------ Raw push/pop for every path ------------------------
+    for (std::size_t size : { 8u, 16u, 24u, 32u, 40u, 64u, 100u }) {
+        SPSC::ErasedRing q(4, size, 8);
+        std::vector<unsigned char> in(size), out(size);
+        for (int r = 0; r < 3; ++r) {
+            for (std::size_t i = 0; i < size; ++i) in[i] = static_cast<unsigned char>(i * 7 + r);
+            assert(q.try_push(in.data()));
+        }
+        assert(!q.try_push(in.data()) && q.size() == 3);        // a ring of 4 holds 3
+        for (int r = 0; r < 3; ++r) {
+            assert(q.try_pop(out.data()));
+            for (std::size_t i = 0; i < size; ++i) assert(out[i] == static_cast<unsigned char>(i * 7 + r));
+        }
+        assert(!q.try_pop(out.data()) && q.empty());
+    }
+
+    // ------------------------ Zero-copy claim/commit, front/pop_front, alignment ------------------------
+    {
+        SPSC::ErasedRing q(16, 48, 32);
+        assert(q.stride() == 64);
+        for (std::uint64_t i = 0; i < 10; ++i) {
+            void* slot = q.claim();
+            assert(slot && reinterpret_cast<std::uintptr_t>(slot) % 32 == 0);
+            std::memcpy(slot, &i, sizeof(i));
+            q.commit();
+        }
+        for (std::uint64_t i = 0; i < 10; ++i) {
+            const void* p = q.front();
+            assert(p && reinterpret_cast<std::uintptr_t>(p) % 32 == 0);
+            std::uint64_t v = 0;
+            std::memcpy(&v, p, sizeof(v));
+            assert(v == i);
+            q.pop_front();
+        }
+        assert(!q.front());
+    }
+
+    // ------------------------ Batches across the wrap point, dense and strided ------------------------
+    for (std::size_t align : { 8u, 32u }) {
+        SPSC::ErasedRing q(8, 24, align);                       // stride 24 (dense) or 32 (strided)
+        std::uint64_t in[3 * 20], out[3 * 20];
+        for (std::uint64_t i = 0; i < 3 * 20; ++i) in[i] = i;
+        std::size_t sent = 0, got = 0;
+        while (got < 20) {
+            sent += q.push_n(in + 3 * sent, std::min<std::size_t>(5, 20 - sent));
+            got += q.pop_n(out + 3 * got, 3);
+        }
+        for (std::uint64_t i = 0; i < 3 * 20; ++i) assert(out[i] == i);
+        assert(q.push_n(in, 100) == 7 && q.pop_n(out, 100) == 7);
+    }
+
+    // ------------------------ Two threads ------------------------
+    {
+        constexpr std::uint64_t N = 200000;
+        SPSC::ErasedRing q(256, 32, 8);
+        std::jthread prod([&] {
+            std::uint64_t rec[4];
+            for (std::uint64_t i = 0; i < N; ++i) {
+                rec[0] = i; rec[3] = ~i;
+                while (!q.try_push(rec)) std::this_thread::yield();
+            }
+        });
+        std::uint64_t rec[4];
+        for (std::uint64_t i = 0; i < N; ++i) {
+            while (!q.try_pop(rec)) std::this_thread::yield();
+            assert(rec[0] == i && rec[3] == ~i);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "spsc_flow.h"
+
+int main() {
+
+    // ------------------------ Cheap operators fuse into one segment --------------------
+    std::uint64_t tapped = 0;
+    auto fused = SPSC::flow<int>()
+        | SPSC::map([](int v) { return v * 2; })
+        | SPSC::filter([](const int& v) { return v % 3 != 0; })
+        | SPSC::tap([&](const int&) { ++tapped; });
+    static_assert(decltype(fused)::segments() == 1);
+
+    // ------------------------ hop() and heavy maps split threads -----------------------
+    auto split = SPSC::flow<int>()
+        | SPSC::map([](int v) { return v + 1; })
+        | SPSC::batch(4)
+        | SPSC::hop()
+        | SPSC::unbatch()
+        | SPSC::map<SPSC::Cost::Heavy>([](int v) { return std::to_string(v); });
+    static_assert(decltype(split)::segments() == 3);
+    static_assert(std::is_same_v<decltype(split)::out_type, std::string>);
+
+    // ------------------------ hop() at a boundary is a no-op (no empty segment) --------
+    auto hops = SPSC::flow<int>() | SPSC::hop() | SPSC::map([](int v) { return v; }) | SPSC::hop() | SPSC::hop();
+    static_assert(decltype(hops)::segments() == 2);
+    static_assert(SPSC::PushStage<SPSC::Segment<int>>);
+
+    // ------------------------ A heavy map that already starts a segment adds nothing ----
+    auto lead = SPSC::flow<int>() | SPSC::map<SPSC::Cost::Heavy>([](int v) { return v; });
+    static_assert(decltype(lead)::segments() == 1);
+
+    // ------------------------ Results match the unfused definition ---------------------
+    SPSC::PipelineOptions opt;
+    opt.ring_cap = 64;
+    auto p = std::move(split).run<SPSC::Wait::Yield>(opt);
+
+    constexpr int kItems = 10003;   // not a multiple of the batch: finish() flushes the tail
+    std::vector<std::string> got;
+    for (int i = 0; i < kItems;) {
+        if (p->try_push(i)) ++i;
+        std::string s;
+        while (p->try_pop(s)) got.push_back(std::move(s));
+    }
+    p->drain([&](std::string s) { got.push_back(std::move(s)); });
+
+    assert(got.size() == static_cast<std::size_t>(kItems));
+    for (int i = 0; i < kItems; ++i) assert(got[i] == std::to_string(i + 1));
+
+    auto q = std::move(fused).run<SPSC::Wait::Yield>(opt);
+    std::vector<int> kept;
+    for (int i = 0; i < 300;) {
+        if (q->try_push(i)) ++i;
+        int v;
+        while (q->try_pop(v)) kept.push_back(v);
+    }
+    q->drain([&](int v) { kept.push_back(v); });
+    assert(kept.size() == 200 && tapped == 200);
+    for (int v : kept) assert(v % 3 != 0);
+    return 0;
+}
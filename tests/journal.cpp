@@ -0,0 +1,177 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <glob.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "spsc_journal.h"
+
+namespace {
+    struct Msg
+    {
+        std::uint64_t id;
+        double px;
+    };
+
+    std::string tempPath()
+    {
+        char path[] = "/tmp/spsc_journal_XXXXXX";
+        int fd = ::mkstemp(path);
+        ::close(fd);
+        ::unlink(path);     // JournalRing creates it
+        return path;
+    }
+}
+
+int main() {
+
+    using Journal = SPSC::JournalRing<Msg>;
+
+    // ------------------------ Restart resumes at the committed head ------------------------
+    {
+        const std::string path = tempPath();
+        {
+            Journal j(path.c_str(), 16, { 0, {} });
+            for (std::uint64_t i = 0; i < 10; ++i) assert(j.try_push(Msg{ i, i * 0.5 }));
+            Msg m{};
+            for (int i = 0; i < 4; ++i) assert(j.try_pop(m));
+            j.checkpoint();
+            for (int i = 0; i < 3; ++i) assert(j.try_pop(m));      // consumed, never committed
+            j.flush();
+        }
+        {
+            Journal j(path.c_str(), 16, { 0, {} });
+            assert(j.recovered() == 0 && j.committed() == 4);
+            Msg m{};
+            for (std::uint64_t i = 4; i < 10; ++i) { assert(j.try_pop(m)); assert(m.id == i && m.px == i * 0.5); }
+            assert(!j.try_pop(m));
+            assert(j.try_push(Msg{ 10, 0 }) && j.try_pop(m) && m.id == 10);
+        }
+        // Geometry mismatch is refused
+        bool threw = false;
+        try { Journal j(path.c_str(), 32); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+        ::unlink(path.c_str());
+    }
+
+    // ------------------------ Full until the consumer commits ------------------------
+    {
+        const std::string path = tempPath();
+        Journal j(path.c_str(), 8, { 0, {} });
+        for (std::uint64_t i = 0; i < 8; ++i) assert(j.try_push(Msg{ i, 0 }));     // all cap slots usable
+        assert(!j.try_push(Msg{ 8, 0 }));
+        Msg m{};
+        assert(j.try_pop(m) && j.try_pop(m));
+        assert(!j.try_push(Msg{ 8, 0 }));       // popped but not committed
+        j.commit();
+        assert(j.try_push(Msg{ 8, 0 }) && j.try_push(Msg{ 9, 0 }));
+        for (std::uint64_t i = 2; i < 10; ++i) assert(j.try_pop(m) && m.id == i);
+        ::unlink(path.c_str());
+    }
+
+    // ------------------------ Torn tail is cut on open ------------------------
+    {
+        const std::string path = tempPath();
+        std::size_t slot_bytes = 0;
+        {
+            Journal j(path.c_str(), 8);
+            for (std::uint64_t i = 0; i < 5; ++i) assert(j.try_push(Msg{ i, 0 }));
+            slot_bytes = Journal::slot_bytes();
+        }
+        // Simulate slot 3 never reaching the disk: zero its seq
+        const int fd = ::open(path.c_str(), O_RDWR);
+        const std::uint64_t zero = 0;
+        const long page = ::sysconf(_SC_PAGESIZE);
+        assert(::pwrite(fd, &zero, sizeof(zero), page + static_cast<long>(3 * slot_bytes)) == sizeof(zero));
+        ::close(fd);
+
+        Journal j(path.c_str(), 8);
+        assert(j.recovered() == 2);
+        Msg m{};
+        for (std::uint64_t i = 0; i < 3; ++i) assert(j.try_pop(m) && m.id == i);
+        assert(!j.try_pop(m));
+        ::unlink(path.c_str());
+    }
+
+    // ------------------------ Torn writeback at a page boundary cuts whole slots ------------------------
+    {
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t per_page = page / Journal::slot_bytes();
+        assert(page % Journal::slot_bytes() == 0);             // no slot straddles a page
+        const std::string path = tempPath();
+        const std::uint64_t n = per_page + per_page / 2;
+        {
+            Journal j(path.c_str(), 2 * per_page);
+            for (std::uint64_t i = 0; i < n; ++i) assert(j.try_push(Msg{ i, 1.0 }));
+        }
+        // Power loss with only the first slot page written back: the second still holds zeros
+        const int fd = ::open(path.c_str(), O_RDWR);
+        const std::vector<char> zeros(page, 0);
+        assert(::pwrite(fd, zeros.data(), page, static_cast<off_t>(2 * page)) == static_cast<ssize_t>(page));
+        ::close(fd);
+
+        Journal j(path.c_str(), 2 * per_page);
+        assert(j.recovered() == n - per_page);
+        Msg m{};
+        for (std::uint64_t i = 0; i < per_page; ++i) assert(j.try_pop(m) && m.id == i && m.px == 1.0);
+        assert(!j.try_pop(m));
+        ::unlink(path.c_str());
+    }
+
+    // ------------------------ Racing creators; an empty file fails instead of hanging ------------------------
+    {
+        const std::string path = tempPath();
+        std::vector<std::thread> openers;
+        for (int t = 0; t < 4; ++t) openers.emplace_back([&] { Journal j(path.c_str(), 64); assert(j.capacity() == 64); });
+        for (auto& t : openers) t.join();
+        glob_t g{};
+        assert(::glob((path + ".*").c_str(), 0, nullptr, &g) == GLOB_NOMATCH);     // no temporary left behind
+        ::globfree(&g);
+        ::unlink(path.c_str());
+
+        // What a creator that died before sizing the file used to leave behind
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        ::close(fd);
+        bool threw = false;
+        try { Journal j(path.c_str(), 64); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+        ::unlink(path.c_str());
+    }
+
+    // ------------------------ Producer and consumer in different processes ------------------------
+    {
+        const std::string path = tempPath();
+        constexpr std::uint64_t kN = 100000;
+        { Journal create(path.c_str(), 256); }
+
+        const pid_t child = ::fork();
+        if (child == 0) {
+            Journal j(path.c_str(), 256);
+            for (std::uint64_t i = 0; i < kN;) {
+                if (j.try_push(Msg{ i, 0 })) ++i;
+                else std::this_thread::yield();
+            }
+            j.flush();
+            std::_Exit(0);
+        }
+
+        Journal j(path.c_str(), 256, { 32, {} });
+        Msg m{};
+        for (std::uint64_t expect = 0; expect < kN;) {
+            if (j.try_pop(m)) { assert(m.id == expect); ++expect; }
+            else std::this_thread::yield();
+        }
+        j.checkpoint();
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        ::unlink(path.c_str());
+    }
+
+    return 0;
+}
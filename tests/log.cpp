@@ -0,0 +1,130 @@
+#include <cassert>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "spsc_log.h"
+
+namespace {
+    std::string readAll(int fd)
+    {
+        std::string s;
+        char buf[4096];
+        ::lseek(fd, 0, SEEK_SET);
+        for (ssize_t n; (n = ::read(fd, buf, sizeof(buf))) > 0;) s.append(buf, static_cast<std::size_t>(n));
+        return s;
+    }
+}
+
+int main() {
+
+    // ------------------------ Record encode/format round trip --------------------------
+    SPSC::LogRecord<64> rec("px={} qty={} side={} ok={} sym={}", 7, -1.5, 42u, std::string_view("B"), true, "AAPL");
+    std::string line;
+    rec.format(line);
+    assert(line == "px=-1.5 qty=42 side=B ok=true sym=AAPL");
+
+    SPSC::LogRecord<9> tiny("{} {}", 0, std::uint64_t{ 1 }, std::uint64_t{ 2 });
+    line.clear();
+    tiny.format(line);
+    assert(line == "1 {}");                  // second argument did not fit
+
+    // ------------------------ Two hot threads, Block policy: nothing lost --------------
+    std::FILE* tmp = std::tmpfile();
+    const int fd = ::fileno(tmp);
+    {
+        SPSC::AsyncLogger::Options opt;
+        opt.ring_cap = 64;
+        opt.policy = SPSC::LogFullPolicy::Block;
+        SPSC::AsyncLogger log(fd, opt);
+
+        std::thread a([&] { for (int i = 0; i < 5000; ++i) log.log("a {}", i); });
+        std::thread b([&] { for (int i = 0; i < 5000; ++i) log.log("b {} {}", i, "x"); });
+        a.join();
+        b.join();
+        assert(log.dropped() == 0);
+    }
+    std::string all = readAll(fd);
+    std::size_t lines = 0;
+    for (char c : all) lines += c == '\n';
+    assert(lines == 10000);
+    assert(all.find("] a 4999\n") != std::string::npos);
+    assert(all.find("] b 4999 x\n") != std::string::npos);
+    std::fclose(tmp);
+
+    // ------------------------ Drop / Overwrite are counted, never block ----------------
+    for (auto policy : { SPSC::LogFullPolicy::Drop, SPSC::LogFullPolicy::Overwrite }) {
+        std::FILE* out = std::tmpfile();
+        std::uint64_t lost = 0;
+        {
+            SPSC::AsyncLogger::Options opt;
+            opt.ring_cap = 2;
+            opt.policy = policy;
+            SPSC::AsyncLogger log(::fileno(out), opt);
+            for (int i = 0; i < 100000; ++i) log.log("{}", i);
+            if (policy == SPSC::LogFullPolicy::Drop) { assert(log.dropped() > 0 && log.overwritten() == 0); lost = log.dropped(); }
+            else                                     { assert(log.overwritten() > 0 && log.dropped() == 0); lost = log.overwritten(); }
+        }
+        const std::string text = readAll(::fileno(out));
+        std::size_t n = 0;
+        for (char c : text) n += c == '\n';
+        assert(n + lost == 100000);                              // every record written or counted
+        if (policy == SPSC::LogFullPolicy::Overwrite)
+            assert(text.find("] 99999\n") != std::string::npos);  // the parked newest record survives
+        std::fclose(out);
+    }
+
+    // ------------------------ Bytes the fd would not take are counted, not lost silently ----
+    {
+        std::signal(SIGPIPE, SIG_IGN);
+        int closed[2], full[2];
+        assert(::pipe(closed) == 0 && ::pipe2(full, O_NONBLOCK) == 0);
+        ::close(closed[0]);                                     // EPIPE on every write
+        for (int fd : { closed[1], full[1] }) {                 // EAGAIN once the pipe fills; nobody reads it
+            SPSC::AsyncLogger::Options opt;
+            opt.flush_bytes = 4096;
+            opt.policy = SPSC::LogFullPolicy::Block;
+            SPSC::AsyncLogger log(fd, opt);
+            for (int i = 0; i < 50000; ++i) log.log("{}", i);
+            for (int spins = 0; log.unwritten_bytes() == 0 && spins < 5000; ++spins)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            assert(log.unwritten_bytes() > 0);
+        }
+        char c;
+        assert(::read(full[0], &c, 1) == 1 && c == '[');        // what fit was written in order
+        ::close(closed[1]);
+        ::close(full[0]);
+        ::close(full[1]);
+    }
+
+    // ------------------------ One thread, two loggers; a logger rebuilt in place -------
+    {
+        std::FILE* out = std::tmpfile();
+        SPSC::AsyncLogger::Options opt;
+        opt.max_threads = 1;
+        opt.policy = SPSC::LogFullPolicy::Block;
+        {
+            SPSC::AsyncLogger a(::fileno(out), opt), b(::fileno(out), opt);
+            for (int i = 0; i < 1000; ++i) { a.log("a {}", i); b.log("b {}", i); }   // one slot each, reused
+        }
+        std::optional<SPSC::AsyncLogger> c;
+        c.emplace(::fileno(out), opt);
+        c->log("c {}", 1);
+        c.reset();
+        c.emplace(::fileno(out), opt);     // same address: must not reuse the dead logger's ring
+        c->log("c {}", 2);
+        c.reset();
+        const std::string text = readAll(::fileno(out));
+        assert(text.find("] a 999\n") != std::string::npos && text.find("] b 999\n") != std::string::npos);
+        assert(text.find("] c 1\n") != std::string::npos && text.find("] c 2\n") != std::string::npos);
+        std::fclose(out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "spsc_merge.h"
+
+struct Tick
+{
+    std::uint64_t ts;
+    std::uint32_t feed;
+};
+
+struct TickTs
+{
+    std::uint64_t operator()(const Tick& t) const noexcept { return t.ts; }
+};
+
+int main() {
+
+    constexpr std::size_t kFeeds = 24;
+    SPSC::TimestampMerge<Tick, TickTs> merge(kFeeds, 64, 100);
+
+    // ------------------------ Interleaved feeds come out globally sorted ---------------
+    for (std::uint64_t t = 0; t < 40; ++t)
+        for (std::uint32_t f = 0; f < kFeeds; ++f)
+            assert(merge.ring(f).try_push(Tick{ t * kFeeds + (f * 7) % kFeeds, f }));
+
+    std::vector<std::uint64_t> seen;
+    std::size_t n = merge.poll(0, [&](Tick& t) { seen.push_back(t.ts); });
+    // Stops when the first feed runs dry: remaining feeds may still hold the next timestamp
+    assert(n == seen.size() && n > 0);
+    for (std::size_t i = 1; i < seen.size(); ++i) assert(seen[i - 1] <= seen[i]);
+
+    // ------------------------ Idle feed stalls only until the lateness bound -----------
+    SPSC::TimestampMerge<Tick, TickTs> gated(3, 16, 100);
+    assert(gated.ring(0).try_push(Tick{ 1000, 0 }));
+    assert(gated.ring(1).try_push(Tick{ 1005, 1 }));
+    std::size_t got = 0;
+    assert(gated.poll(1050, [&](Tick&) { ++got; }) == 0);   // feed 2 idle, 1000 not yet stale
+    assert(gated.poll(1100, [&](Tick& t) { assert(t.ts == 1000); ++got; }) == 1);
+    assert(gated.poll(1105, [&](Tick& t) { assert(t.ts == 1005); ++got; }) == 1);
+    assert(got == 2);
+
+    // ------------------------ Feed arrival unblocks immediately and late data is counted
+    assert(gated.ring(0).try_push(Tick{ 2000, 0 }));
+    assert(gated.ring(1).try_push(Tick{ 2001, 1 }));
+    assert(gated.ring(2).try_push(Tick{ 990, 2 }));          // behind what was emitted
+    std::vector<std::uint64_t> order;
+    gated.poll(2001, [&](Tick& t) { order.push_back(t.ts); });
+    assert((order == std::vector<std::uint64_t>{ 990 }));   // feed 2 idle again after 990
+    assert(gated.late() == 1);
+    gated.poll(2101, [&](Tick& t) { order.push_back(t.ts); }, 1);
+    assert((order == std::vector<std::uint64_t>{ 990, 2000 }));
+
+    // ------------------------ Unbounded lateness: waits for idle feeds, no overflow ----
+    {
+        SPSC::TimestampMerge<Tick, TickTs> strict(2, 16, UINT64_MAX);
+        assert(strict.ring(0).try_push(Tick{ 5, 0 }));
+        assert(strict.poll(UINT64_MAX - 1, [](Tick&) {}) == 0);   // ts + lateness used to wrap to 4
+        assert(strict.ring(1).try_push(Tick{ 7, 1 }));
+        std::vector<std::uint64_t> out;
+        strict.poll(UINT64_MAX - 1, [&](Tick& t) { out.push_back(t.ts); });
+        assert((out == std::vector<std::uint64_t>{ 5 }));         // feed 0 idle again after 5
+
+        SPSC::TimestampMerge<Tick, TickTs> early(2, 16, 10);
+        assert(early.ring(0).try_push(Tick{ 500, 0 }));
+        assert(early.poll(100, [](Tick&) {}) == 0);                // head stamped after now: wait
+    }
+    return 0;
+}
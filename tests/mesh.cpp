@@ -0,0 +1,94 @@
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "spsc_mesh.h"
+
+struct Msg
+{
+    std::uint32_t from;
+    std::uint32_t seq;
+};
+
+int main() {
+
+    constexpr std::size_t kShards = 4;
+    constexpr std::uint32_t kPerPair = 5000;
+
+    SPSC::ShardMesh<Msg> mesh(kShards, 128, { 0, 0, 0, 0 });
+
+    // ------------------------ Rings live in the shared arena, grouped by receiver -----
+    for (std::size_t to = 0; to < kShards; ++to) {
+        assert(mesh.ring((to + 1) % kShards, to).capacity() == 128);
+    }
+
+    // ------------------------ Staged sends are invisible until flushed -----------------
+    assert(mesh.port(0).send(1, Msg{ 0, 0 }));
+    assert(mesh.port(1).poll([](std::size_t, Msg&) {}) == 0);
+    mesh.port(0).flush(1);
+    std::size_t seen = mesh.port(1).poll([](std::size_t from, Msg& m) { assert(from == 0 && m.seq == 0); });
+    assert(seen == 1);
+
+    // ------------------------ No ring to self: rejected, never staged ------------------
+    {
+        int threw = 0;
+        try { mesh.port(2).send(2, Msg{ 2, 0 }); } catch (const std::invalid_argument&) { ++threw; }
+        try { mesh.port(2).send(kShards, Msg{ 2, 0 }); } catch (const std::invalid_argument&) { ++threw; }
+        assert(threw == 2);
+        mesh.port(2).flush(2);
+        mesh.port(2).flush();
+        for (std::size_t r = 0; r < kShards; ++r) assert(mesh.port(r).poll([](std::size_t, Msg&) {}) == 0);
+    }
+
+    // ------------------------ Zero shards throws; one shard has no rings --------------
+    {
+        bool threw = false;
+        try { SPSC::ShardMesh<Msg> none(0, 128); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+
+        SPSC::ShardMesh<Msg> solo(1, 128);
+        assert(solo.shards() == 1 && solo.port(0).id() == 0);
+        threw = false;
+        try { solo.port(0).send(0, Msg{ 0, 0 }); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+        solo.port(0).flush();
+        assert(solo.port(0).poll([](std::size_t, Msg&) {}) == 0);
+    }
+
+    // ------------------------ All-to-all, per-pair FIFO --------------------------------
+    std::vector<std::thread> shards;
+    for (std::size_t me = 0; me < kShards; ++me) {
+        shards.emplace_back([&, me] {
+            auto& port = mesh.port(me);
+            std::vector<std::uint32_t> next_out(kShards, 0), next_in(kShards, 0);
+            std::size_t received = 0;
+            const std::size_t expect = (kShards - 1) * kPerPair;
+
+            auto on_msg = [&](std::size_t from, Msg& m) {
+                assert(m.from == from);
+                assert(m.seq == next_in[from]);
+                ++next_in[from];
+                ++received;
+            };
+
+            bool sending = true;
+            while (sending || received < expect) {
+                sending = false;
+                for (std::size_t to = 0; to < kShards; ++to) {
+                    if (to == me || next_out[to] == kPerPair) continue;
+                    sending = true;
+                    for (int b = 0; b < 16 && next_out[to] < kPerPair; ++b) {
+                        if (!port.send(to, Msg{ static_cast<std::uint32_t>(me), next_out[to] })) break;
+                        ++next_out[to];
+                    }
+                }
+                port.flush();
+                if (!port.poll(on_msg)) std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& t : shards) t.join();
+    return 0;
+}
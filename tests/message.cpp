@@ -0,0 +1,124 @@
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <variant>
+
+#include "spsc_message.h"
+
+namespace {
+    struct Heartbeat { std::uint32_t seq; };
+    struct Quote { std::uint64_t id; double bid, ask; std::uint32_t bid_qty, ask_qty; };
+    struct alignas(16) Trade { std::uint64_t id; double px; std::uint64_t qty; };
+    struct Note { std::string text; };
+    struct Big { char bytes[200]; };
+
+    using Msgs = SPSC::MessageRing<Heartbeat, Quote, Trade, Note, Big>;
+
+    // Each record is its own size plus the header, not the largest alternative
+    static_assert(Msgs::footprint<Heartbeat>() == 16);
+    static_assert(Msgs::footprint<Quote>() == 48);
+    static_assert(Msgs::footprint<Big>() == 208);
+    static_assert(Msgs::footprint<Heartbeat>() < sizeof(std::variant<Heartbeat, Quote, Trade, Note, Big>));
+}
+
+int main() {
+
+    // ------------------------ Mixed types, in-place dispatch, FIFO across types ------------------------
+    {
+        Msgs q(1024);
+        assert(q.try_emplace<Heartbeat>(1u));
+        assert(q.try_push(Quote{ 7, 99.5, 100.5, 10, 20 }));
+        assert(q.try_emplace<Note>(std::string(100, 'n')));
+        assert(q.try_push(Trade{ 7, 100.0, 5 }));
+
+        int order = 0;
+        auto visit = SPSC::Overloaded{
+            [&](Heartbeat& h) { assert(order++ == 0 && h.seq == 1); },
+            [&](Quote& qu) { assert(order++ == 1 && qu.id == 7 && qu.ask_qty == 20); },
+            [&](Note& n) { assert(order++ == 2 && n.text.size() == 100); },
+            [&](Trade& t) { assert(order++ == 3 && t.qty == 5); assert(reinterpret_cast<std::uintptr_t>(&t) % 16 == 0); },
+            [&](Big&) { assert(false); },
+        };
+        assert(q.poll(visit) == 4 && order == 4);
+        assert(q.empty() && !q.try_dispatch(visit));
+    }
+
+    // ------------------------ Full ring, wrap with pad records ------------------------
+    {
+        Msgs q(512);
+        std::size_t pushed = 0;
+        while (q.try_emplace<Quote>(Quote{ pushed, 0, 0, 0, 0 })) ++pushed;
+        assert(pushed == 512 / Msgs::footprint<Quote>());
+
+        std::uint64_t next = 0;
+        auto check = SPSC::Overloaded{
+            [&](Quote& qu) { assert(qu.id == next++); },
+            [&](Big& b) { assert(b.bytes[0] == 'b' && b.bytes[199] == 'B'); ++next; },
+            [](auto&) { assert(false); },
+        };
+        for (int round = 0; round < 200; ++round) {                  // mixed sizes walk the wrap point around
+            while (q.try_dispatch(check)) {}
+            if (round % 3 == 0) {
+                Big b{};
+                b.bytes[0] = 'b'; b.bytes[199] = 'B';
+                assert(q.try_push(b));
+                ++pushed;
+            }
+            while (q.try_emplace<Quote>(Quote{ pushed, 0, 0, 0, 0 })) ++pushed;
+        }
+        while (q.try_dispatch(check)) {}
+        assert(next == pushed);
+    }
+
+    // ------------------------ Destruction: handled, thrown-through and left-over messages ------------------------
+    {
+        auto owner = std::make_shared<int>(0);
+        struct Owned { std::shared_ptr<int> p; };
+        {
+            SPSC::MessageRing<Owned, Heartbeat> q(256);
+            for (int i = 0; i < 4; ++i) assert(q.try_emplace<Owned>(owner));
+            assert(owner.use_count() == 5);
+            bool threw = false;
+            try {
+                q.poll(SPSC::Overloaded{ [](Owned&) { throw std::runtime_error("handler"); }, [](Heartbeat&) {} });
+            } catch (const std::runtime_error&) { threw = true; }
+            assert(threw && owner.use_count() == 4);
+            assert(q.poll(SPSC::Overloaded{ [](Owned&) {}, [](Heartbeat&) {} }, 1) == 1);
+            assert(owner.use_count() == 3);
+        }
+        assert(owner.use_count() == 1);
+    }
+
+    // ------------------------ Two threads, staged bursts ------------------------
+    {
+        constexpr std::uint64_t N = 100000;
+        SPSC::MessageRing<Heartbeat, Trade, Big> q(4096);
+        std::jthread prod([&] {
+            for (std::uint64_t i = 0; i < N; ++i) {
+                bool ok = false;
+                while (!ok) {
+                    switch (i % 3) {
+                        case 0: ok = q.try_stage<Heartbeat>(static_cast<std::uint32_t>(i)); break;
+                        case 1: ok = q.try_stage<Trade>(Trade{ i, 1.0, i }); break;
+                        default: { Big b{}; b.bytes[0] = static_cast<char>(i); ok = q.try_stage<Big>(b); }
+                    }
+                    if (!ok) { q.publish(); std::this_thread::yield(); }
+                }
+                if ((i & 7) == 7) q.publish();
+            }
+            q.publish();
+        });
+        std::uint64_t seen = 0;
+        auto consume = SPSC::Overloaded{
+            [&](Heartbeat& h) { assert(h.seq == static_cast<std::uint32_t>(seen)); ++seen; },
+            [&](Trade& t) { assert(t.id == seen); ++seen; },
+            [&](Big& b) { assert(b.bytes[0] == static_cast<char>(seen)); ++seen; },
+        };
+        while (seen < N) if (!q.poll(consume, 64)) std::this_thread::yield();
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "spsc_channel.h"
+#include "spsc_ring.h"
+
+int main() {
+
+    // ------------------------ Handoff not visible yet: try_adopt fails ------------------------
+    {
+        SPSC::SpscRing<int> q(8);
+        assert(!q.try_adopt_producer(1));
+        const std::uint32_t h = q.handoff_producer();
+        assert(h == 1 && q.try_adopt_producer(h));
+        assert(q.handoff_producer() == 2 && q.try_adopt_producer(1));      // later handoffs cover earlier ones
+    }
+
+    // ------------------------ SpscRing: both roles hop across threads mid-stream ------------------------
+    {
+        constexpr std::uint64_t N = 60000;
+        constexpr int Hops = 6;
+        SPSC::SpscRing<std::uint64_t> q(64);
+        std::atomic<std::uint32_t> prod_h{ 0 }, cons_h{ 0 };    // relaxed on purpose: the baton orders
+
+        auto producer = [&](int leg) {
+            const std::uint64_t from = N * leg / Hops, to = N * (leg + 1) / Hops;
+            if (leg) q.adopt_producer(leg);
+            for (std::uint64_t i = from; i < to; ++i) {
+                while (!q.try_stage(i)) { q.publish(); std::this_thread::yield(); }
+            }
+            // leave the last few staged: the next thread publishes them
+            prod_h.store(q.handoff_producer(), std::memory_order_relaxed);
+        };
+        auto consumer = [&](int leg) {
+            const std::uint64_t from = N * leg / Hops, to = N * (leg + 1) / Hops;
+            if (leg) q.adopt_consumer(leg);
+            std::uint64_t v = 0;
+            for (std::uint64_t i = from; i < to; ++i) {
+                while (!q.try_pop(v)) std::this_thread::yield();
+                assert(v == i);
+            }
+            cons_h.store(q.handoff_consumer(), std::memory_order_relaxed);
+        };
+
+        std::vector<std::jthread> threads;
+        for (int leg = 0; leg < Hops; ++leg) {
+            threads.emplace_back(producer, leg);
+            threads.emplace_back(consumer, leg);
+        }
+        std::jthread tail([&] { q.adopt_producer(Hops); q.publish(); });
+        threads.clear();
+        tail.join();
+        assert(prod_h.load() == Hops && cons_h.load() == Hops);
+        assert(q.empty());
+    }
+
+    // ------------------------ Channel ends shared in place, threads change ------------------------
+    {
+        constexpr std::uint64_t N = 30000;
+        auto [tx, rx] = SPSC::makeChannel<std::uint64_t>(32);
+
+        std::uint32_t h = 0;
+        std::jthread([&] {
+            for (std::uint64_t i = 0; i < 20; ++i) assert(tx.try_stage(i));
+            h = tx.handoff();                   // staged, unpublished, cached head: all handed over
+        }).join();
+        std::jthread prod([&, h] {
+            tx.adopt(h);
+            assert(tx.staged() == 20 && tx.pushed() == 20);
+            for (std::uint64_t i = 20; i < N; ++i) {
+                while (!tx.try_stage(i)) { tx.publish(); std::this_thread::yield(); }
+            }
+            tx.publish();
+        });
+
+        std::uint32_t c = 0;
+        std::jthread([&] {
+            std::uint64_t v = 0;
+            for (std::uint64_t i = 0; i < N / 2; ++i) { while (!rx.try_pop(v)) std::this_thread::yield(); assert(v == i); }
+            c = rx.handoff();
+        }).join();
+        std::jthread cons([&, c] {
+            rx.adopt(c);
+            std::uint64_t v = 0;
+            for (std::uint64_t i = N / 2; i < N; ++i) { while (!rx.try_pop(v)) std::this_thread::yield(); assert(v == i); }
+            assert(rx.popped() == N);
+        });
+    }
+
+    return 0;
+}
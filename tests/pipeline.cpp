@@ -0,0 +1,81 @@
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "spsc_pipeline.h"
+
+namespace {
+    struct Halve
+    {
+        using out_type = double;        // unrelated to the push-stage interface
+        double operator()(int v) const { return v / 2.0; }
+    };
+}
+
+int main() {
+
+    constexpr std::uint64_t kItems = 100000;
+
+    // ------------------------ Types flow stage to stage, order is preserved ------------
+    SPSC::PipelineOptions opt;
+    opt.ring_cap = 256;
+    opt.batch = 16;
+    opt.cpus = { 0, -1 };
+
+    auto p = SPSC::makePipeline<std::uint64_t, SPSC::Wait::Yield>(opt,
+        [](std::uint64_t v) { return v * 3; },
+        [](std::uint64_t v) { return std::to_string(v); },
+        [](std::string s) { return s.size(); });
+
+    std::uint64_t sent = 0, got = 0;
+    std::size_t digits = 0;
+    while (sent < kItems) {
+        if (p->try_push(sent)) ++sent;
+        std::size_t n = 0;
+        while (p->try_pop(n)) { digits += n; ++got; }
+        if (sent % 4096 == 0) std::this_thread::yield();
+    }
+
+    // ------------------------ drain(sink) delivers everything accepted --------------------
+    p->drain([&](std::size_t n) { digits += n; ++got; });
+    assert(p->finished());
+    assert(got == kItems);
+
+    std::size_t expect = 0;
+    for (std::uint64_t v = 0; v < kItems; ++v) expect += std::to_string(v * 3).size();
+    assert(digits == expect);
+
+    // ------------------------ A functor naming out_type is still a 1:1 stage ----------
+    static_assert(!SPSC::PushStage<Halve>);
+    {
+        auto h = SPSC::makePipeline<int, SPSC::Wait::Yield>(SPSC::PipelineOptions{}, Halve{});
+        while (!h->try_push(5)) std::this_thread::yield();
+        double out = 0;
+        h->drain([&](double v) { out = v; });
+        assert(out == 2.5);
+    }
+
+    // ------------------------ stop() abandons in-flight work without hanging ----------
+    auto q = SPSC::makePipeline<int>(SPSC::PipelineOptions{}, [](int v) { return v + 1; });
+    for (int i = 0; i < 100; ++i) q->try_push(i);
+    q->stop();
+    assert(!q->finished());
+
+    // ------------------------ drain() after stop() returns what got through ------------
+    std::size_t through = 0;
+    q->drain([&](int) { ++through; });
+    assert(!q->finished() && through <= 100);
+
+    {
+        SPSC::PipelineOptions small;
+        small.ring_cap = 4;
+        auto r = SPSC::makePipeline<int>(small, [](int v) { return v; }, [](int v) { return v; });
+        for (int i = 0; i < 8; ++i) r->try_push(i);
+        r->stop();                                           // last stage may be parked on a full output()
+        std::size_t n = 0;
+        r->drain([&](int) { ++n; });
+        assert(n <= 8);
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "spsc_ring.h"
+
+namespace {
+    using Default = SPSC::SpscRing<std::uint64_t>;
+    using Spelled = SPSC::SpscRing<std::uint64_t, SPSC::CachedIndex, SPSC::HeapStorage, SPSC::Wait::SpinPause, SPSC::NoStats>;
+    using Dual    = SPSC::SpscRing<std::uint64_t, SPSC::DualCachedIndex>;
+    using Counted = SPSC::SpscRing<std::uint64_t, SPSC::CachedIndex, SPSC::HeapStorage, SPSC::Wait::Yield, SPSC::RingStats>;
+
+    // Unused policies leave no bytes behind
+    static_assert(std::is_same_v<Default, Spelled>);
+    static_assert(sizeof(SPSC::SpscRing<std::uint64_t, SPSC::PlainIndex>) == sizeof(Default));
+    static_assert(sizeof(Dual) == sizeof(Default) + 64);        // one consumer-private line
+    static_assert(sizeof(Counted) == sizeof(Default) + 64);
+    static_assert(SPSC::SpscRing<std::uint32_t, SPSC::CachedIndex, SPSC::PaddedStorage>::storage_bytes(8) == 8 * 64);
+    static_assert(Default::storage_bytes(8) == 8 * sizeof(std::uint64_t));
+
+    // Push n, pop n across two threads with the blocking push()/pop()
+    template <class Ring>
+    void roundTrip(Ring& q, std::uint64_t n)
+    {
+        std::jthread prod([&] { for (std::uint64_t i = 0; i < n; ++i) q.push(i); });
+        std::uint64_t v = 0;
+        for (std::uint64_t i = 0; i < n; ++i) { q.pop(v); assert(v == i); }
+    }
+}
+
+int main() {
+
+    // ------------------------ Every index / storage mix moves the same stream ------------------------
+    {
+        SPSC::SpscRing<std::uint64_t, SPSC::PlainIndex, SPSC::HeapStorage, SPSC::Wait::Yield> a(64);
+        SPSC::SpscRing<std::uint64_t, SPSC::DualCachedIndex, SPSC::PaddedStorage, SPSC::Wait::Yield> b(64);
+        SPSC::SpscRing<std::uint64_t, SPSC::CachedIndex, SPSC::HugePageStorage, SPSC::Wait::Yield> c(1 << 12);
+        Counted d(64);
+        roundTrip(a, 50000);
+        roundTrip(b, 50000);
+        roundTrip(c, 50000);
+        roundTrip(d, 50000);
+        assert(a.empty() && b.empty() && c.empty() && d.empty());
+    }
+
+    // ------------------------ Dual cache: staged burst, one refresh per drain ------------------------
+    {
+        SPSC::SpscRing<std::string, SPSC::DualCachedIndex> q(8);
+        for (int i = 0; i < 5; ++i) assert(q.try_stage(std::to_string(i)));
+        std::string s;
+        assert(!q.try_pop(s));                  // nothing published yet
+        q.publish();
+        for (int i = 0; i < 5; ++i) { assert(q.try_pop(s)); assert(s == std::to_string(i)); }
+        assert(!q.try_pop(s));
+        assert(q.try_push("x") && q.front() && *q.front() == "x");
+        q.pop_front();
+    }
+
+    // ------------------------ Stats ------------------------
+    {
+        Counted q(4);
+        std::uint64_t v = 0;
+        assert(!q.try_pop(v));
+        for (std::uint64_t i = 0; i < 4; ++i) q.try_push(i);   // 3 fit
+        assert(q.try_pop(v) && q.try_pop(v));
+        auto rs = q.read_spans();
+        q.consume(rs.size());
+        const auto st = q.stats();
+        assert(st.pushes == 3 && st.full == 1 && st.pops == 3 && st.empty == 1);
+    }
+
+    return 0;
+}
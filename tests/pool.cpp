@@ -0,0 +1,46 @@
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+
+#include "spsc_pool.h"
+
+namespace {
+    std::atomic<std::uint64_t> g_sum{ 0 };
+
+    void add(void* arg) { g_sum.fetch_add(reinterpret_cast<std::uintptr_t>(arg), std::memory_order_relaxed); }
+
+    void slow_add(void* arg)
+    {
+        std::this_thread::yield();
+        add(arg);
+    }
+}
+
+int main() {
+
+    SPSC::StealPool<SPSC::Wait::Yield>::Options opt;
+    opt.workers = 3;
+    opt.inbox_cap = 8192;
+    SPSC::StealPool<SPSC::Wait::Yield> pool(opt);
+
+    // ------------------------ Round-robin submission runs every task once --------------
+    std::uint64_t expect = 0;
+    for (std::uintptr_t i = 1; i <= 20000; ++i) {
+        while (!pool.submit(SPSC::Task{ &add, reinterpret_cast<void*>(i) })) std::this_thread::yield();
+        expect += i;
+    }
+    pool.wait_idle();
+    assert(g_sum.load() == expect);
+
+    // ------------------------ All work on one worker: others must steal to help --------
+    for (std::uintptr_t i = 1; i <= 4000; ++i) {
+        while (!pool.submit_to(0, SPSC::Task{ &slow_add, reinterpret_cast<void*>(i) })) std::this_thread::yield();
+        expect += i;
+    }
+    pool.wait_idle();
+    assert(g_sum.load() == expect);
+    assert(pool.completed() == 24000);
+    assert(pool.stolen() > 0);
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "spsc_reorder.h"
+
+int main() {
+
+    constexpr std::size_t kWorkers = 3;
+    constexpr std::uint64_t kItems = 50000;
+
+    SPSC::ReorderStage<std::uint64_t> stage(kWorkers, 64, 100);
+    assert(stage.window() == 128);     // rounded up to a power of two
+
+    // ------------------------ Workers finish out of order (uneven work per item) -------
+    std::vector<std::jthread> workers;
+    for (std::size_t i = 0; i < kWorkers; ++i) {
+        workers.emplace_back([&stage, i](std::stop_token st) {
+            SPSC::Sequenced<std::uint64_t> job{};
+            while (!st.stop_requested()) {
+                if (!stage.to_worker(i).try_pop(job)) { std::this_thread::yield(); continue; }
+                if (job.seq % 7 == i) std::this_thread::yield();
+                job.value *= 2;
+                while (!stage.from_worker(i).try_push(job)) std::this_thread::yield();
+            }
+        });
+    }
+
+    // ------------------------ Output order equals input order --------------------------
+    std::uint64_t sent = 0, expect = 0;
+    while (expect < kItems) {
+        while (sent < kItems && stage.dispatch(sent)) ++sent;
+        assert(stage.in_flight() <= stage.window());
+        stage.poll([&](std::uint64_t v) { assert(v == 2 * expect); ++expect; });
+        std::this_thread::yield();
+    }
+    assert(stage.in_flight() == 0);
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <cassert>
+#include <cstddef>
+
+#include "spsc_router.h"
+
+int main() {
+
+    // ------------------------ Cached estimate tracks the producer's own pushes ---------
+    SPSC::SpscRing<int> ring(8);
+    assert(ring.producer_size() == 0);
+    for (int i = 0; i < 3; ++i) assert(ring.try_push(i));
+    assert(ring.producer_size() == 3);
+
+    int out = 0;
+    assert(ring.try_pop(out) && out == 0);
+    assert(ring.producer_size() == 3);     // stale until refreshed
+    assert(ring.refresh_head() == 2);
+
+    // ------------------------ Empty rings share load evenly ----------------------------
+    SPSC::ShortestQueueRouter<int> router(4, 16, 0);
+    std::size_t hits[4]{};
+    for (int i = 0; i < 8; ++i) {
+        std::size_t lane = router.push(i);
+        assert(lane < 4);
+        ++hits[lane];
+    }
+    for (std::size_t h : hits) assert(h == 2);
+
+    // ------------------------ Drained ring becomes the shortest after refresh ----------
+    while (router.ring(2).try_pop(out)) {}
+    router.refresh();
+    assert(router.pick() == 2);
+    assert(router.push(99) == 2);
+
+    // ------------------------ Full everywhere is reported, not blocked on --------------
+    SPSC::ShortestQueueRouter<int> tiny(2, 2, 1);
+    assert(tiny.push(1) < 2);
+    assert(tiny.push(2) < 2);
+    assert(tiny.push(3) == 2);
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <cassert>
+#include <csignal>
+#include <cstdint>
+
+#include "spsc_ring.h"
+
+namespace {
+    struct Sample
+    {
+        std::uint64_t seq;
+        void* pc[4];
+    };
+
+    SPSC::SpscRing<Sample>* g_ring = nullptr;
+    volatile std::sig_atomic_t g_seq = 0;
+    volatile std::sig_atomic_t g_dropped = 0;
+
+    extern "C" void onSignal(int)
+    {
+        Sample s{ static_cast<std::uint64_t>(g_seq), { __builtin_return_address(0), nullptr, nullptr, nullptr } };
+        g_seq = g_seq + 1;
+        if (!g_ring->try_push_signal_safe(s)) g_dropped = g_dropped + 1;
+    }
+}
+
+int main() {
+
+    SPSC::SpscRing<Sample> ring(16);
+    g_ring = &ring;
+
+    struct sigaction sa{};
+    sa.sa_handler = onSignal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGUSR1, &sa, nullptr);
+
+    // ------------------------ Handler is the producer, main thread the consumer --------
+    for (int i = 0; i < 20; ++i) std::raise(SIGUSR1);
+    assert(g_dropped == 5);                   // 15 usable slots
+
+    Sample out{};
+    for (std::uint64_t i = 0; i < 15; ++i) {
+        assert(ring.try_pop(out));
+        assert(out.seq == i);
+    }
+    assert(!ring.try_pop(out));
+
+    std::raise(SIGUSR1);
+    assert(ring.try_pop(out) && out.seq == 20);
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "spsc_sink.h"
+
+#if SPSC_HAS_IO_URING
+    #include <cstddef>
+    #include <linux/filter.h>
+    #include <linux/seccomp.h>
+    #include <sys/prctl.h>
+#endif
+
+namespace {
+    struct Rec
+    {
+        std::uint64_t seq;
+        std::uint32_t pad[6];
+    };
+
+    // Push [from, to) into the ring, asserting it fits
+    void fill(SPSC::SpscRing<Rec>& ring, std::uint64_t from, std::uint64_t to)
+    {
+        for (std::uint64_t i = from; i < to; ++i) assert(ring.try_push(Rec{ i, { static_cast<std::uint32_t>(i) } }));
+    }
+
+    void verify(const char* path, std::uint64_t n)
+    {
+        struct stat st{};
+        assert(::stat(path, &st) == 0);
+        assert(static_cast<std::uint64_t>(st.st_size) == n * sizeof(Rec));
+        std::vector<Rec> back(n);
+        int fd = ::open(path, O_RDONLY);
+        assert(::read(fd, back.data(), n * sizeof(Rec)) == static_cast<ssize_t>(n * sizeof(Rec)));
+        ::close(fd);
+        for (std::uint64_t i = 0; i < n; ++i) assert(back[i].seq == i && back[i].pad[0] == i);
+    }
+
+    int openTemp(char* path, bool direct)
+    {
+        int fd = ::mkstemp(path);
+        assert(fd >= 0);
+        if (!direct) return fd;
+        ::close(fd);
+        fd = ::open(path, O_WRONLY | O_DIRECT);
+        return fd >= 0 ? fd : ::open(path, O_WRONLY);   // tmpfs and friends refuse O_DIRECT
+    }
+
+#if SPSC_HAS_IO_URING
+    // From here on io_uring_enter fails with EBUSY in this process; false if seccomp is unavailable
+    bool failUringEnter()
+    {
+        sock_filter prog[] = {
+            BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, nr)),
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_io_uring_enter, 0, 1),
+            BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | EBUSY),
+            BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+        };
+        sock_fprog fprog{ static_cast<unsigned short>(sizeof(prog) / sizeof(prog[0])), prog };
+        return ::prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) == 0 && ::prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &fprog) == 0;
+    }
+#endif
+}
+
+int main() {
+
+    // ------------------------ read_spans: two runs once the tail wraps ------------------------
+    {
+        SPSC::SpscRing<Rec> ring(8);
+        fill(ring, 0, 6);
+        ring.consume(4);
+        fill(ring, 6, 11);                      // tail wraps to index 3
+        auto s = ring.read_spans();
+        assert(s.first.size() == 4 && s.second.size() == 3);
+        assert(s.first[0].seq == 4 && s.second[0].seq == 8 && s.second[2].seq == 10);
+        ring.consume(s.size());
+        assert(ring.empty() && ring.read_spans().size() == 0);
+    }
+
+    // ------------------------ Writev: wrap case, group commit by size ------------------------
+    {
+        char path[] = "/tmp/spsc_sink_XXXXXX";
+        int fd = openTemp(path, false);
+        SPSC::SpscRing<Rec> ring(16);
+        SPSC::FileSink<Rec>::Options opt;
+        opt.sync_bytes = 20 * sizeof(Rec);
+        SPSC::FileSink<Rec> sink(fd, opt);
+
+        std::uint64_t next = 0;
+        for (int round = 0; round < 10; ++round) {
+            fill(ring, next, next + 11);
+            next += 11;
+            assert(sink.drain(ring) == 11);
+        }
+        assert(sink.records() == 110);
+        assert(sink.syncs() == 5 && sink.durable() == 110);    // every second drain crosses 20 records
+        verify(path, next);
+        ::close(fd);
+        ::unlink(path);
+    }
+
+    // ------------------------ Direct: blocks, partial flush, rewrite in place ------------------------
+    for (bool uring : { true, false }) {
+        char path[] = "/tmp/spsc_sink_XXXXXX";
+        int fd = openTemp(path, true);
+        SPSC::SpscRing<Rec> ring(64);
+        SPSC::FileSink<Rec>::Options opt;
+        opt.mode = SPSC::SinkMode::Direct;
+        opt.block_bytes = 4096;
+        opt.io_uring = uring;
+        SPSC::FileSink<Rec> sink(fd, opt);
+        if (!uring) assert(!sink.uses_io_uring());
+
+        std::uint64_t next = 0;
+        for (int round = 0; round < 40; ++round) {
+            fill(ring, next, next + 50);
+            next += 50;
+            sink.drain(ring);
+            if (round == 7) { sink.flush(); verify(path, next); }   // mid-block flush
+        }
+        sink.sync();
+        assert(sink.durable() == next);
+        verify(path, next);
+        ::close(fd);
+        ::unlink(path);
+    }
+
+#if SPSC_HAS_IO_URING
+    // ------------------------ Direct: io_uring_enter refused, SQE withdrawn, pwrite fallback ------------------------
+    {
+        char path[] = "/tmp/spsc_sink_XXXXXX";
+        int fd = openTemp(path, true);
+        const pid_t pid = ::fork();
+        assert(pid >= 0);
+        if (pid == 0) {     // the seccomp filter cannot be lifted, so it lives in a child
+            SPSC::SpscRing<Rec> ring(256);
+            SPSC::FileSink<Rec>::Options opt;
+            opt.mode = SPSC::SinkMode::Direct;
+            opt.block_bytes = 4096;
+            SPSC::FileSink<Rec> sink(fd, opt);
+            SPSC::Detail::Uring probe(4);
+            if (!sink.uses_io_uring() || !probe.ok() || !failUringEnter()) ::_exit(0);
+
+            int buf = 0;
+            if (probe.write(fd, &buf, sizeof(buf), 0, 7)) ::_exit(1);      // refused, so not submitted
+            if (probe.pending() != 0) ::_exit(2);                           // and not left in the ring
+
+            std::uint64_t next = 0;
+            for (int round = 0; round < 8; ++round) {
+                fill(ring, next, next + 200);
+                next += 200;
+                sink.drain(ring);
+            }
+            sink.flush();
+            verify(path, next);
+            ::_exit(0);
+        }
+        int status = 0;
+        assert(::waitpid(pid, &status, 0) == pid);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        ::close(fd);
+        ::unlink(path);
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+
+#include "spsc_source.h"
+
+namespace {
+    std::string writeTemp(const std::string& bytes)
+    {
+        char path[] = "/tmp/spsc_source_XXXXXX";
+        int fd = ::mkstemp(path);
+        assert(fd >= 0);
+        assert(::write(fd, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size()));
+        ::close(fd);
+        return path;
+    }
+
+    std::string_view text(const SPSC::RecordView& v)
+    {
+        return { reinterpret_cast<const char*>(v.data), v.size };
+    }
+}
+
+int main() {
+
+    // ------------------------ Lines: views point into the mapping ------------------------
+    {
+        const std::string path = writeTemp("alpha\nbeta\n\ngamma");
+        SPSC::MappedFile file(path.c_str());
+        SPSC::MappedSource<> src(file);
+        SPSC::SpscRing<SPSC::RecordView> ring(8);
+
+        assert(src.pump(ring) == 4 && src.done() && src.trailing() == 0);
+        const char* expect[] = { "alpha", "beta", "", "gamma" };
+        for (const char* e : expect) {
+            SPSC::RecordView v{};
+            assert(ring.try_pop(v));
+            assert(text(v) == e);
+            assert(v.data == file.data() + v.offset);       // no copy
+        }
+        ::unlink(path.c_str());
+    }
+
+    // ------------------------ Length-prefixed with a truncated tail; ring back-pressure ----------
+    {
+        std::string bytes;
+        for (std::uint32_t i = 0; i < 100; ++i) {
+            std::string body(i % 7, static_cast<char>('a' + i % 26));
+            std::uint32_t len = static_cast<std::uint32_t>(body.size());
+            bytes.append(reinterpret_cast<const char*>(&len), 4).append(body);
+        }
+        std::uint32_t torn = 50;
+        bytes.append(reinterpret_cast<const char*>(&torn), 4).append("xyz");   // header promises 50, 3 present
+        const std::string path = writeTemp(bytes);
+
+        SPSC::MappedFile file(path.c_str());
+        SPSC::MappedSource<SPSC::Framing::LengthPrefixed<>> src(file, {}, 4096);
+        SPSC::SpscRing<SPSC::RecordView> ring(16);
+
+        std::uint32_t seen = 0;
+        while (!src.done() || !ring.empty()) {
+            src.pump(ring, 10);
+            for (SPSC::RecordView* v; (v = ring.front()); ring.pop_front(), ++seen) {
+                assert(v->size == seen % 7);
+                for (std::size_t k = 0; k < v->size; ++k) assert(static_cast<char>(v->data[k]) == static_cast<char>('a' + seen % 26));
+            }
+        }
+        assert(seen == 100);
+        assert(src.trailing() == 7);
+        ::unlink(path.c_str());
+    }
+
+    // ------------------------ Threaded replay of fixed-size records ------------------------
+    {
+        std::string bytes;
+        for (std::uint64_t i = 0; i < 50000; ++i) bytes.append(reinterpret_cast<const char*>(&i), 8);
+        const std::string path = writeTemp(bytes);
+
+        SPSC::MappedFile file(path.c_str());
+        SPSC::MappedSource<SPSC::Framing::Fixed> src(file, { 8 }, 64 * 1024);
+        SPSC::SpscRing<SPSC::RecordView> ring(256);
+
+        std::thread producer([&] { src.run(ring); });
+        for (std::uint64_t expect = 0; expect < 50000;) {
+            if (SPSC::RecordView* v = ring.front()) {
+                std::uint64_t got;
+                std::memcpy(&got, v->data, 8);
+                assert(got == expect && v->offset == expect * 8);
+                ring.pop_front();
+                ++expect;
+            }
+        }
+        producer.join();
+        assert(ring.empty());
+        ::unlink(path.c_str());
+    }
+
+    // ------------------------ Empty file ------------------------
+    {
+        const std::string path = writeTemp("");
+        SPSC::MappedFile file(path.c_str());
+        SPSC::MappedSource<> src(file);
+        SPSC::SpscRing<SPSC::RecordView> ring(4);
+        assert(src.done() && src.pump(ring) == 0);
+        ::unlink(path.c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <cassert>
+#include <cstdint>
+#include <thread>
+
+#include "spsc_spill.h"
+
+namespace {
+    struct Tick
+    {
+        std::uint64_t seq;
+        std::uint64_t px;
+    };
+}
+
+int main() {
+
+    // ------------------------ Overflow spills, FIFO preserved, switch back ------------------------
+    {
+        SPSC::SpillRing<Tick> q(8, { "/tmp", 4 * sizeof(Tick) });
+        for (std::uint64_t i = 0; i < 7; ++i) q.push(Tick{ i, i });
+        assert(!q.spilling());
+        q.push(Tick{ 7, 7 });                   // ring full: spill mode
+        assert(q.spilling() && q.spilled() == 1);
+        for (std::uint64_t i = 8; i < 30; ++i) q.push(Tick{ i, i });
+        q.flush();
+        assert(q.spilled() == 23);
+
+        Tick t{};
+        for (std::uint64_t i = 0; i < 20; ++i) { assert(q.try_pop(t)); assert(t.seq == i); }
+        assert(q.spilling());
+        q.push(Tick{ 30, 30 });                 // backlog not cleared yet: still spilled
+        q.flush();
+        assert(q.spilling());
+        for (std::uint64_t i = 20; i < 31; ++i) { assert(q.try_pop(t)); assert(t.seq == i); }
+        assert(!q.try_pop(t) && q.backlog() == 0);
+
+        q.push(Tick{ 31, 31 });                 // consumer caught up: back to the ring
+        assert(!q.spilling());
+        assert(q.try_pop(t) && t.seq == 31);
+
+        // A second spill episode reuses the truncated file
+        for (std::uint64_t i = 32; i < 60; ++i) q.push(Tick{ i, i });
+        assert(q.spilling());
+        q.flush();
+        for (std::uint64_t i = 32; i < 60; ++i) { assert(q.try_pop(t)); assert(t.seq == i); }
+        assert(!q.try_pop(t));
+    }
+
+    // ------------------------ Bursty producer, slow consumer: nothing lost or reordered ----------
+    {
+        constexpr std::uint64_t kN = 200000;
+        SPSC::SpillRing<Tick> q(64, { "/tmp", 1024 });
+        std::thread producer([&] {
+            for (std::uint64_t i = 0; i < kN; ++i) {
+                q.push(Tick{ i, i * 3 });
+                if ((i & 4095) == 4095) { q.flush(); std::this_thread::yield(); }
+            }
+            q.flush();
+        });
+        Tick t{};
+        for (std::uint64_t expect = 0; expect < kN;) {
+            if (q.try_pop(t)) { assert(t.seq == expect && t.px == expect * 3); ++expect; }
+            else std::this_thread::yield();
+        }
+        producer.join();
+        assert(!q.try_pop(t));
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <cassert>
+#include <cstdint>
+
+#include "spsc_trace.h"
+
+int main() {
+
+    constexpr std::size_t kHops = 2;
+    using Msg = SPSC::Traced<std::uint64_t, kHops>;
+
+    SPSC::TracedRing<std::uint64_t, kHops> a(16), b(16);
+    SPSC::TraceSampler sampler(3);     // rounded up to 1 in 4
+    SPSC::TraceCollector<kHops> collector;
+
+    // ------------------------ Two hops: source -> a -> stage -> b -> sink -------------
+    std::uint64_t sampled = 0;
+    for (std::uint64_t i = 0; i < 64; ++i) {
+        Msg m{ i, {} };
+        m.trace.sampled = sampler.next();
+        sampled += m.trace.sampled;
+        assert(a.try_push(std::move(m)));
+
+        Msg mid{};
+        assert(a.try_pop(mid));
+        mid.value *= 2;
+        assert(b.try_push(std::move(mid)));
+
+        Msg out{};
+        assert(b.try_pop(out));
+        assert(out.value == 2 * i);
+        if (out.trace.sampled) {
+            assert(out.trace.hop == kHops);
+            for (std::size_t s = 1; s < 2 * kHops; ++s) assert(out.trace.stamps[s] >= out.trace.stamps[s - 1]);
+        } else {
+            assert(out.trace.hop == 0 && out.trace.stamps[0] == 0);
+        }
+        collector.record(out.trace);
+    }
+
+    // ------------------------ Histograms see only sampled messages ---------------------
+    assert(sampled == 16);
+    assert(collector.queueing(0).count() == 16);
+    assert(collector.queueing(1).count() == 16);
+    assert(collector.processing(0).count() == 16);
+    assert(collector.processing(1).count() == 0);     // nothing after the last ring
+    assert(collector.end_to_end().count() == 16);
+    assert(collector.end_to_end().quantile(0.5) <= collector.end_to_end().quantile(1.0));
+
+    SPSC::LatencyHistogram h;
+    for (std::uint64_t v : { 0ull, 1ull, 5ull, 100ull }) h.add(v);
+    assert(h.quantile(0.0) == 0 && h.quantile(1.0) == 127 && h.max() == 100);
+    return 0;
+}